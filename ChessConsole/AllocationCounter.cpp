@@ -0,0 +1,163 @@
+#include "AllocationCounter.h"
+
+#ifdef ALLOCATION_CHECK
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+namespace
+{
+	std::atomic<std::uint64_t> allocation_count{};
+
+	void* counted_allocate(const std::size_t size) noexcept
+	{
+		allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+		return std::malloc(size ? size : 1);
+	}
+
+	void* counted_allocate(const std::size_t size, const std::align_val_t alignment) noexcept
+	{
+		allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+		const std::size_t align{ static_cast<std::size_t>(alignment) };
+
+#ifdef _MSC_VER
+		return _aligned_malloc(size ? size : 1, align);
+#else
+		//aligned_alloc wants a size that is a multiple of the alignment
+		const std::size_t rounded{ ((size ? size : 1) + align - 1) / align * align };
+		return std::aligned_alloc(align, rounded);
+#endif
+	}
+
+	void aligned_free(void* memory) noexcept
+	{
+#ifdef _MSC_VER
+		_aligned_free(memory);
+#else
+		std::free(memory);
+#endif
+	}
+
+	void* throw_if_null(void* memory)
+	{
+		if (!memory)
+		{
+			throw std::bad_alloc();
+		}
+
+		return memory;
+	}
+}
+
+std::uint64_t heap_allocation_count()
+{
+	return allocation_count.load(std::memory_order_relaxed);
+}
+
+//every form of new and delete goes through these so nothing can allocate without being counted
+void* operator new(const std::size_t size)
+{
+	return throw_if_null(counted_allocate(size));
+}
+
+void* operator new[](const std::size_t size)
+{
+	return throw_if_null(counted_allocate(size));
+}
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept
+{
+	return counted_allocate(size);
+}
+
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept
+{
+	return counted_allocate(size);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment)
+{
+	return throw_if_null(counted_allocate(size, alignment));
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment)
+{
+	return throw_if_null(counted_allocate(size, alignment));
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return counted_allocate(size, alignment);
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return counted_allocate(size, alignment);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+	aligned_free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+	aligned_free(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+	aligned_free(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept
+{
+	aligned_free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	aligned_free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	aligned_free(memory);
+}
+#endif
\ No newline at end of file
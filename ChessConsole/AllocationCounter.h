@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstdint>
+
+//only built with ALLOCATION_CHECK defined, the Debug configurations set it and Release keeps the default allocator
+#ifdef ALLOCATION_CHECK
+//global operator new is replaced in AllocationCounter.cpp so the search can be checked for heap allocations
+std::uint64_t heap_allocation_count();
+#endif
\ No newline at end of file
@@ -13,31 +13,83 @@ private:
 	std::uint64_t m_board;
 
 public:
-	BitBoard();
+	//the small accessors are constexpr so the attack tables can be built out of bitboards at compile time
+	constexpr BitBoard()
+		: m_board() {}
 
-	BitBoard(std::uint64_t board);
+	constexpr BitBoard(std::uint64_t board)
+		: m_board(board) {}
 
-	std::uint64_t board() const;
+	constexpr std::uint64_t board() const
+	{
+		return m_board;
+	}
 
 	std::size_t bitCount() const;
 
-	void setBoard(std::uint64_t board);
+	constexpr void setBoard(std::uint64_t board)
+	{
+		m_board = board;
+	}
 
 	void print() const;
 
-	void set(const std::size_t i);
-
-	void set_rf(const std::size_t r, const std::size_t f);
-
-	bool set_rf_safe(const std::size_t r, const std::size_t f);
-
-	void reset(const std::size_t i);
-
-	bool test(const std::size_t i) const;
-
-	bool test_rf(const std::size_t r, const std::size_t f) const;
+	constexpr void set(const std::size_t i)
+	{
+		m_board |= (std::uint64_t{ 1 } << i);
+	}
+
+	constexpr void set_rf(const std::size_t r, const std::size_t f)
+	{
+		set(bitset_index(f, r));
+	}
+
+	constexpr bool set_rf_safe(const std::size_t r, const std::size_t f)
+	{
+		if (f < FILE_MAX && r < RANK_MAX)
+		{
+			set(bitset_index(f, r));
+			return true;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	constexpr void reset(const std::size_t i)
+	{
+		m_board ^= (std::uint64_t{ 1 } << i);
+	}
+
+	constexpr bool test(const std::size_t i) const
+	{
+		return (m_board & (std::uint64_t{ 1 } << i)) != 0;
+	}
+
+	constexpr bool test_rf(const std::size_t r, const std::size_t f) const
+	{
+		return test(bitset_index(f, r));
+	}
 
 	std::size_t find_1lsb() const;
 
-	static size_t bitset_index(const std::size_t x, const std::size_t y);
-};
\ No newline at end of file
+	static constexpr std::size_t bitset_index(const std::size_t x, const std::size_t y)
+	{
+		return y * FILE_MAX + x;
+	}
+};
+
+//moves every bit of a board D squares, a positive D moves towards h1 and a negative one towards a8
+template<int D>
+constexpr std::uint64_t shift(const std::uint64_t board)
+{
+	if constexpr (D > 0)
+	{
+		return board << D;
+	}
+	else
+	{
+		return board >> -D;
+	}
+}
\ No newline at end of file
@@ -9,28 +9,75 @@
 using namespace std::literals::string_view_literals;
 
 constexpr std::uint64_t single_bit									= 1;
+constexpr std::uint64_t file_a_mask									= 0x0101010101010101;
+constexpr std::uint64_t file_h_mask									= 0x8080808080808080;
+constexpr std::uint64_t rank_8_mask									= 0x00000000000000FF; //a8 is bit 0
+constexpr std::uint64_t rank_5_mask									= 0x00000000FF000000;
+constexpr std::uint64_t rank_4_mask									= 0x000000FF00000000;
+constexpr std::uint64_t rank_1_mask									= 0xFF00000000000000;
 constexpr std::size_t   RANK_MAX									= 8;
 constexpr std::size_t   FILE_MAX									= 8;
 constexpr std::size_t   MAX_BOARD_POSITIONS = FILE_MAX * RANK_MAX;	//64
 constexpr std::size_t   WHITE_COLOR									= 0;
 constexpr std::size_t   BLACK_COLOR									= 1;
 constexpr std::size_t   MAX_COLORS									= 2;
-constexpr std::size_t   MAGIC_ITERATION_COUNT						= 1000000;
+constexpr std::size_t   MAGIC_TRIAL_BATCH							= 4096; //magic candidates tried between clock checks
 constexpr std::size_t   MAX_BISHOP_ATTACKS							= 512;
 constexpr std::size_t   MAX_ROOK_ATTACKS							= 4096;
+constexpr std::size_t   PEXT_ATTACK_TABLE_SIZE						= 107648; //one entry per subset of every mask, 5248 bishop and 102400 rook
 constexpr std::size_t   PIECE_COUNT									= 12;
 constexpr std::size_t   MAX_MOVELIST_COUNT							= 256;
 constexpr std::uint32_t MAX_MINIMAX_DEPTH							= INT_MAX - 1;
 constexpr std::size_t   TIME_EVALUATION_NODE_DELAY					= 1000;
 constexpr std::size_t   MAX_EVALUATION_TIME_SECONDS					= 1; //maybe remove
-
-constexpr bool USING_PREGENERATED_MAGICS = true;//TODO: seperate actual constants from options
-constexpr bool PRINT_GENERATED_MAGICS = false;
+constexpr std::size_t   TRANSPOSITION_TABLE_SIZE_MB					= 64;
+constexpr std::size_t   TRANSPOSITION_BUCKET_SIZE					= 4;
+constexpr std::size_t   DEFAULT_THREAD_COUNT						= 1;
+constexpr std::size_t   MAX_SEARCH_PLY								= 128;
+constexpr std::size_t   PERFT_TABLE_SIZE_MB							= 256;
+constexpr std::size_t   MAX_KILLER_MOVES							= 2;
+constexpr int           CHECKMATE_SCORE								= 30000;
+constexpr int           CHECKMATE_THRESHOLD							= CHECKMATE_SCORE - 1000; //scores above this are mates
+constexpr int           INFINITE_SCORE								= CHECKMATE_SCORE + 1; //outside every real score, used for the starting window
+constexpr int           DELTA_PRUNING_MARGIN						= 200;
+constexpr std::uint32_t NULL_MOVE_MIN_DEPTH							= 3;
+constexpr std::uint32_t NULL_MOVE_REDUCTION							= 2; //grows by one for every NULL_MOVE_REDUCTION_STEP plies of depth
+constexpr std::uint32_t NULL_MOVE_REDUCTION_STEP					= 6;
+constexpr std::uint32_t NULL_MOVE_VERIFY_DEPTH						= 10; //from here a null move cutoff is checked with a reduced normal search
+constexpr std::size_t   MAX_QUIETS_SEARCHED							= 64; //quiet moves remembered per ply for the history penalty, later ones go unpenalized
+constexpr int           HISTORY_MAX									= 16384; //history scores stay inside plus or minus this
+constexpr int           HISTORY_MAX_BONUS							= HISTORY_MAX / 4; //reached by a single cutoff at depth 8
+constexpr int           HISTORY_LMR_DIVISOR							= 8192; //history score worth one ply less or more reduction
+constexpr std::uint32_t LMR_MIN_DEPTH								= 3;
+constexpr std::size_t   LMR_MIN_MOVES								= 3; //moves searched at full depth before any is reduced
+constexpr std::size_t   LMR_MAX_MOVES								= 64; //later moves share the last column of the reduction table
+constexpr int           ASPIRATION_WINDOW							= 50; //first half width around the last score, doubled after every fail
+constexpr std::uint32_t ASPIRATION_MIN_DEPTH						= 4; //shallower scores swing too much to centre a window on
+
+constexpr bool USE_PEXT_WHEN_AVAILABLE = true;//TODO: seperate actual constants from options
 constexpr bool ENGINE_PLAY_ITSELF = false;
 constexpr bool PLAYER_PLAY_ITSELF = false;
 
-const std::string start_position_fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR";
-const std::string tricky_position_fen = "r3k2r/p11pqpb1/bn2pnp1/2pPN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R";
+const std::string start_position_fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+const std::string tricky_position_fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+
+//known perft results, depths are picked so the whole suite runs in a few seconds in release mode
+struct PerftPosition
+{
+	std::string_view fen;
+	std::uint32_t depth;
+	std::uint64_t nodes;
+};
+
+constexpr std::array<PerftPosition, 7> perft_suite = {{
+	{ "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"sv, 6, 119060324 },
+	{ "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"sv, 5, 193690690 },
+	{ "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"sv, 6, 11030083 },
+	{ "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"sv, 5, 15833292 },
+	{ "r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1"sv, 5, 15833292 },
+	{ "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"sv, 5, 89941194 },
+	{ "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"sv, 5, 164075551 }
+}};
 
 //most valuable victim - least valuable aggressor [capturing piece][captured piece]
 constexpr std::array<std::array<std::uint8_t, PIECE_COUNT>, PIECE_COUNT> mvv_lva = {{
@@ -123,6 +170,9 @@ constexpr std::array<int, PIECE_COUNT> piece_value = {
 	-0,   //black king
 };
 
+//piece values used by the static exchange evaluation, the king outweighs any exchange so it is never given up
+constexpr std::array<int, 6> see_value = { 100, 300, 300, 500, 900, 20000 };
+
 enum Castle {
 	WK = 0b0001,
 	WQ = 0b0010, 
@@ -135,6 +185,11 @@ enum Color {
 	BLACK = 1
 };
 
+constexpr Color other_color(const Color color)
+{
+	return color == Color::WHITE ? Color::BLACK : Color::WHITE;
+}
+
 enum Occupancy {
 	WHITEOCC = 0,
 	BLACKOCC = 1,
@@ -152,6 +207,18 @@ enum RF {
 	a1, b1, c1, d1, e1, f1, g1, h1, no_sqr
 };
 
+//how slider attacks are looked up, PEXT needs BMI2 and is picked at startup when the cpu runs it fast
+enum SliderBackend {
+	MAGIC,
+	PEXT
+};
+
+enum GenType {
+	ALL_MOVES,
+	CAPTURE_MOVES, //captures, enpassant and every promotion
+	QUIET_MOVES    //everything else, including castles
+};
+
 enum MoveType {
 	QUIET,
 	CAPTURE,
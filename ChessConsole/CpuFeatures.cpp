@@ -0,0 +1,54 @@
+#include "CpuFeatures.h"
+#include <intrin.h>
+#include <array>
+#include <cstring>
+
+namespace
+{
+	bool detect_fast_pext()
+	{
+		std::array<int, 4> registers{};
+
+		__cpuid(registers.data(), 0);
+		const int max_leaf{ registers[0] };
+
+		//the vendor string is spread over ebx, edx, ecx in that order
+		char vendor[13]{};
+		std::memcpy(vendor, &registers[1], 4);
+		std::memcpy(vendor + 4, &registers[3], 4);
+		std::memcpy(vendor + 8, &registers[2], 4);
+
+		if (max_leaf < 7)
+		{
+			return false;
+		}
+
+		//leaf 7 ebx bit 8 is BMI2
+		__cpuidex(registers.data(), 7, 0);
+
+		if (!(registers[1] & (1 << 8)))
+		{
+			return false;
+		}
+
+		if (std::strcmp(vendor, "AuthenticAMD") == 0)
+		{
+			//family 0x19 is Zen 3, the extended family is only added when the base family is 0xF
+			__cpuid(registers.data(), 1);
+			const int base_family{ (registers[0] >> 8) & 0xF };
+			const int family{ base_family == 0xF ? base_family + ((registers[0] >> 20) & 0xFF) : base_family };
+
+			return family >= 0x19;
+		}
+
+		return true;
+	}
+}
+
+bool cpu_has_fast_pext()
+{
+	//CPUID is slow and every MoveGen asks, the answer cannot change while the program runs
+	static const bool fast_pext{ detect_fast_pext() };
+
+	return fast_pext;
+}
\ No newline at end of file
@@ -0,0 +1,5 @@
+#pragma once
+
+//BMI2 is present and PEXT runs in hardware, AMD cores before Zen 3 support it in microcode that is slower than a magic lookup
+//CPUID only runs on the first call, the answer is cached for the rest of the program
+bool cpu_has_fast_pext();
\ No newline at end of file
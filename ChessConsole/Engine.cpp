@@ -1,240 +1,427 @@
 #include "Engine.h"
+#include "AllocationCounter.h"
+#include <iomanip>
 
 Engine::Engine()
-	: m_moveGen(), m_state(), m_bestMove(), m_evaluations(), m_nodes(), m_prunes(), m_seconds(), m_mates(), m_depth(), m_depthSearched(), m_stopSearch(), m_timeCheckCount(), 
-	m_bestMoveFinal(), m_moveSource() {}
+	: m_moveGen(), m_transpositionTable(TRANSPOSITION_TABLE_SIZE_MB), m_threadCount(DEFAULT_THREAD_COUNT), m_stopSearch(), m_searchStats(), m_state(), m_bestMoveFinal(), m_principalVariation(), m_depthSearched(), m_moveSource() {}
 
 Engine::Engine(std::string_view fen)
-	: m_moveGen(), m_state(State::parse_fen(fen)), m_bestMove(), m_evaluations(), m_nodes(), m_prunes(), m_seconds(), m_mates(), m_depth(), m_depthSearched(), m_stopSearch(), 
-	m_timeCheckCount(), m_bestMoveFinal(), m_moveSource() {}
+	: m_moveGen(), m_transpositionTable(TRANSPOSITION_TABLE_SIZE_MB), m_threadCount(DEFAULT_THREAD_COUNT), m_stopSearch(), m_searchStats(), m_state(State::parse_fen(fen)), m_bestMoveFinal(), m_principalVariation(), m_depthSearched(), 
+	m_moveSource() {}
 
 
 
 void Engine::setState(std::string_view fen)
 {
 	m_state = State::parse_fen(fen);
+	m_transpositionTable.clear();
 }
 
-int Engine::evaluate(const State& state)
+void Engine::setHashSize(const std::size_t megabytes)
 {
-	m_evaluations++;
+	m_transpositionTable.resize(megabytes);
+}
+
+void Engine::setThreadCount(const std::size_t thread_count)
+{
+	m_threadCount = std::max<std::size_t>(thread_count, 1);
+}
+
+std::size_t Engine::threadCount() const
+{
+	return m_threadCount;
+}
+
+void Engine::iterativeMinimax(const State& state, const std::uint32_t max_depth, const bool time_limited)
+{
+	m_stopSearch = false;
+
+	//entries from earlier moves are kept but lose priority when buckets fill up
+	m_transpositionTable.incrementAge();
+
+	//every thread keeps a few hundred kilobytes of per ply scratch, so they are made for this search and freed when it ends
+	std::vector<std::unique_ptr<SearchThread>> search_threads;
+	search_threads.reserve(m_threadCount);
+
+	for (std::size_t id{}; id < m_threadCount; id++)
+	{
+		search_threads.push_back(std::make_unique<SearchThread>(id, m_moveGen, m_transpositionTable, m_stopSearch));
+	}
+
+	//helpers share the table and the stop flag, everything else is private to each thread
+	std::vector<std::thread> helpers;
+	helpers.reserve(m_threadCount - 1);
 
-	int evaluation{};
+	for (std::size_t id{ 1 }; id < m_threadCount; id++)
+	{
+		helpers.emplace_back([&, id]() { search_threads[id]->iterativeMinimax(state, max_depth, time_limited); });
+	}
+
+	search_threads[0]->iterativeMinimax(state, max_depth, time_limited);
+
+	//main thread is done either by time or depth, bring the helpers down with it
+	m_stopSearch = true;
+
+	for (auto& helper : helpers)
+	{
+		helper.join();
+	}
+
+	//add up the stats and take the deepest completed iteration, the main thread wins ties
+	const SearchThread* best_thread{ search_threads[0].get() };
+	m_searchStats = SearchStats();
 
-	for (std::size_t piece{}; piece < PIECE_COUNT; piece++)
+	for (const auto& thread : search_threads)
 	{
-		BitBoard piece_board = state.positions()[piece];
+		m_searchStats += thread->stats();
 
-		while (piece_board.board())
+		if (thread->depthSearched() > best_thread->depthSearched() && thread->bestMove().data())
 		{
-			const std::size_t square = piece_board.find_1lsb();
-			const BitBoard attack = m_moveGen.getPieceAttack(piece, square, state);
+			best_thread = thread.get();
+		}
+	}
 
-			evaluation += piece_value[piece];
-			evaluation += static_cast<int>(attack.bitCount());
+	m_bestMoveFinal = best_thread->bestMove();
+	m_principalVariation = best_thread->principalVariation();
+	m_depthSearched = best_thread->depthSearched();
+
+	//time ran out before any thread finished depth 1, the first legal move is still better than a null move
+	if (!m_bestMoveFinal.data())
+	{
+		MoveList list;
+		m_moveGen.generateMoves(state, list);
 
-			piece_board.reset(square);
+		if (list.count())
+		{
+			m_bestMoveFinal = list.moves()[0];
 		}
 	}
+}
 
-	return evaluation;
+SearchStats Engine::searchStats() const
+{
+	return m_searchStats;
 }
 
-int Engine::minimax(const State& state, const std::uint32_t depth, int alpha, int beta)
+void Engine::timeToDepthReport(const std::uint32_t depth)
 {
-	m_nodes++;
+	constexpr std::array<std::size_t, 5> thread_counts{ 1, 2, 4, 8, 16 };
 
-	if (depth == 0)
+	const std::size_t previous_thread_count{ threadCount() };
+	double single_thread_seconds{};
+
+	std::cout << "time to depth " << depth << std::endl;
+	std::cout << "threads    seconds        nodes      nodes/s   speedup   move" << std::endl;
+
+	for (const std::size_t thread_count : thread_counts)
 	{
-		return evaluate(state);
+		//every run starts cold so the threads are not helped by the previous run
+		setThreadCount(thread_count);
+		m_transpositionTable.clear();
+
+		const auto start_time{ std::chrono::steady_clock::now() };
+		iterativeMinimax(m_state, depth, false);
+		const std::chrono::duration<double> duration{ std::chrono::steady_clock::now() - start_time };
+
+		const SearchStats stats{ searchStats() };
+		const double seconds{ duration.count() };
+
+		if (thread_count == 1)
+		{
+			single_thread_seconds = seconds;
+		}
+
+		std::cout << std::setw(7) << thread_count
+			<< std::setw(11) << std::fixed << std::setprecision(3) << seconds
+			<< std::setw(13) << stats.nodes
+			<< std::setw(13) << static_cast<std::uint64_t>(stats.nodes / std::max(seconds, 0.001))
+			<< std::setw(10) << std::setprecision(2) << single_thread_seconds / std::max(seconds, 0.001)
+			<< "   " << index_to_rf[m_bestMoveFinal.source()] << index_to_rf[m_bestMoveFinal.target()] << std::endl;
 	}
 
-	//time cutoff for iterative deepening
-	if (m_stopSearch)
+	setThreadCount(previous_thread_count);
+}
+
+void Engine::searchBenchmark(const std::uint32_t depth)
+{
+	SearchStats total{};
+	double total_seconds{};
+
+	std::cout << "search benchmark, depth " << depth << ", " << threadCount() << " threads" << std::endl;
+	std::cout << "position        nodes    seconds   windows  fail low fail high   move" << std::endl;
+
+	for (std::size_t i{}; i < perft_suite.size(); i++)
 	{
-		return state.whiteToMove() ? INT_MAX : INT_MIN;
+		//every position starts cold so the counts do not depend on the order they run in
+		m_transpositionTable.clear();
+
+		const auto start_time{ std::chrono::steady_clock::now() };
+		iterativeMinimax(State::parse_fen(perft_suite[i].fen), depth, false);
+		const std::chrono::duration<double> duration{ std::chrono::steady_clock::now() - start_time };
+
+		const SearchStats stats{ searchStats() };
+		total += stats;
+		total_seconds += duration.count();
+
+		std::cout << std::setw(8) << i
+			<< std::setw(13) << stats.nodes
+			<< std::setw(11) << std::fixed << std::setprecision(3) << duration.count()
+			<< std::setw(10) << stats.aspirationSearches
+			<< std::setw(10) << stats.aspirationFailLows
+			<< std::setw(10) << stats.aspirationFailHighs
+			<< "   " << m_bestMoveFinal.toString() << std::endl;
 	}
 
-	//only test time every 1000 nodes to avoid frequent system calls
-	if (m_timeCheckCount >= TIME_EVALUATION_NODE_DELAY)
+	std::cout << std::setw(8) << "total"
+		<< std::setw(13) << total.nodes
+		<< std::setw(11) << total_seconds
+		<< std::setw(10) << total.aspirationSearches
+		<< std::setw(10) << total.aspirationFailLows
+		<< std::setw(10) << total.aspirationFailHighs << std::endl;
+}
+
+void Engine::makeMoveBenchmark(const std::uint32_t depth)
+{
+	//one list per ply so neither version pays for allocations
+	std::vector<MoveList> lists(depth + 1);
+
+	std::cout << "make move benchmark, perft " << depth << std::endl;
+	std::cout << "position          nodes    copy make  make unmake   speedup" << std::endl;
+
+	for (std::size_t i{}; i < perft_suite.size(); i++)
 	{
-		const auto now{ std::chrono::high_resolution_clock::now() };
-		const std::chrono::duration<float> duration{ now - m_searchStartTime };
+		const State state{ State::parse_fen(perft_suite[i].fen) };
+
+		const auto copy_start{ std::chrono::steady_clock::now() };
+		const std::uint64_t copy_nodes{ perftCopyMake(state, depth, lists) };
+		const std::chrono::duration<double> copy_duration{ std::chrono::steady_clock::now() - copy_start };
+
+		State in_place{ state };
 
-		if (static_cast<size_t>(duration.count()) >= MAX_EVALUATION_TIME_SECONDS)
+		const auto unmake_start{ std::chrono::steady_clock::now() };
+		const std::uint64_t unmake_nodes{ perftMakeUnmake(in_place, depth, lists) };
+		const std::chrono::duration<double> unmake_duration{ std::chrono::steady_clock::now() - unmake_start };
+
+		std::cout << std::setw(8) << i
+			<< std::setw(15) << copy_nodes
+			<< std::setw(13) << std::fixed << std::setprecision(3) << copy_duration.count()
+			<< std::setw(13) << unmake_duration.count()
+			<< std::setw(10) << std::setprecision(2) << copy_duration.count() / std::max(unmake_duration.count(), 0.001);
+
+		if (copy_nodes != unmake_nodes || in_place.hash() != state.hash())
 		{
-			m_stopSearch = true;
-			return state.whiteToMove() ? INT_MAX : INT_MIN;
+			std::cout << "   mismatch, make unmake counted " << unmake_nodes;
 		}
 
-		m_timeCheckCount = 0;
+		std::cout << std::endl;
 	}
+}
 
-	m_timeCheckCount++;
+void Engine::perft(std::string_view fen, const std::uint32_t depth) const
+{
+	State state{ State::parse_fen(fen) };
+	Perft perft{ m_moveGen };
 
-	if (state.whiteToMove())
-	{
-		MoveList moves;
-		m_moveGen.generateMoves(state, moves);
-		moves.sortMoveList();
+	perft.divide(state, depth);
+}
 
-		int max_eval{ INT_MIN };
-		bool anyLegalMoves{ false };
+bool Engine::perftSuite() const
+{
+	Perft perft{ m_moveGen };
 
-		for (Move move : moves.moves())
-		{
-			State new_state{ state };
+	return perft.runSuite();
+}
 
-			if (makeMove(move, new_state))
-			{
-				anyLegalMoves = true;
+bool Engine::allocationCheck(const std::uint32_t depth)
+{
+#ifndef ALLOCATION_CHECK
+	std::cout << "allocation check needs a build with ALLOCATION_CHECK defined, the Debug configurations set it" << std::endl;
+	return false;
+#else
+	const State state{ State::parse_fen(tricky_position_fen) };
+
+	//the thread and its per ply stacks are set up before counting, only the search itself has to stay off the heap
+	m_transpositionTable.clear();
+	m_stopSearch = false;
+	const std::unique_ptr<SearchThread> thread{ std::make_unique<SearchThread>(0, m_moveGen, m_transpositionTable, m_stopSearch) };
 
-				new_state.flipSide();
+	const std::uint64_t allocations_before{ heap_allocation_count() };
+	thread->iterativeMinimax(state, depth, false);
+	const std::uint64_t allocations{ heap_allocation_count() - allocations_before };
 
-				const int eval = minimax(new_state, depth - 1, alpha, beta);
+	std::cout << "allocation check, kiwipete depth " << depth << ", " << thread->stats().nodes << " nodes, " << allocations << " heap allocations" << std::endl;
 
-				//time cutoff for iterative deepening
-				if (m_stopSearch)
-				{
-					return state.whiteToMove() ? INT_MAX : INT_MIN;
-				}
+	if (allocations != 0)
+	{
+		std::cout << "FAILED, the search should not touch the heap" << std::endl;
+	}
 
-				if (eval > max_eval)
-				{
-					max_eval = eval;
+	return allocations == 0;
+#endif
+}
 
-					if (depth == m_depth)
-					{
-						m_bestMove = move;
-					}
-				}
+void Engine::parallelPerftReport(std::string_view fen, const std::uint32_t depth) const
+{
+	const State state{ State::parse_fen(fen) };
+	const std::size_t core_count{ std::max<std::size_t>(std::thread::hardware_concurrency(), 1) };
 
-				if (alpha < eval)
-				{
-					alpha = eval;
-				}
+	std::vector<std::size_t> thread_counts;
+	for (std::size_t thread_count{ 1 }; thread_count < core_count; thread_count *= 2)
+	{
+		thread_counts.push_back(thread_count);
+	}
+	thread_counts.push_back(core_count);
 
-				if (beta <= alpha)
-				{
-					m_prunes++;
-					break;
-				}
-			}
-		}
+	PerftTable table{ PERFT_TABLE_SIZE_MB };
+	ParallelPerft perft{ m_moveGen, &table };
+
+	double single_thread_seconds{};
+	std::uint64_t single_thread_nodes{};
+
+	std::cout << "hashed perft " << depth << ", " << table.sizeMB() << " MB table" << std::endl;
+	std::cout << "threads    seconds            nodes        nodes/s   speedup  hit rate   steals" << std::endl;
 
-		if (anyLegalMoves)
+	for (const std::size_t thread_count : thread_counts)
+	{
+		//every run starts cold so the hit rate is not helped by the previous run
+		table.clear();
+
+		const ParallelPerftResult result{ perft.run(state, depth, thread_count) };
+
+		if (thread_count == 1)
 		{
-			return max_eval;
+			single_thread_seconds = result.seconds;
+			single_thread_nodes = result.nodes;
 		}
-		else
+
+		std::cout << std::setw(7) << thread_count
+			<< std::setw(11) << std::fixed << std::setprecision(3) << result.seconds
+			<< std::setw(17) << result.nodes
+			<< std::setw(15) << static_cast<std::uint64_t>(result.nodes / std::max(result.seconds, 0.001))
+			<< std::setw(10) << std::setprecision(2) << single_thread_seconds / std::max(result.seconds, 0.001)
+			<< std::setw(9) << std::setprecision(1) << 100.0 * result.hits / std::max<std::uint64_t>(result.probes, 1) << "%"
+			<< std::setw(9) << result.steals;
+
+		//a different total means two threads raced on a table slot or the move generator depends on the order
+		if (result.nodes != single_thread_nodes)
 		{
-			if (kingInCheck(state))
-			{
-				//white checkmate
-				m_mates++;
-				return INT_MIN + depth + 1;
-			}
-			else
-			{
-				//white stalemate
-				return 0;
-			}
+			std::cout << "   mismatch";
 		}
-	}
-	else
-	{
-		MoveList moves;
-		m_moveGen.generateMoves(state, moves);
-		moves.sortMoveList();
 
-		int min_eval{ INT_MAX };
-		bool anyLegalMoves{ false };
+		std::cout << std::endl;
+	}
+}
 
-		for (Move move : moves.moves())
-		{
-			State new_state{ state };
+void Engine::sliderBackendBenchmark()
+{
+	constexpr std::array<SliderBackend, 2> backends{ SliderBackend::MAGIC, SliderBackend::PEXT };
+	constexpr std::array<std::string_view, 2> backend_names{ "magic"sv, "pext"sv };
 
-			if (makeMove(move, new_state))
-			{
-				anyLegalMoves = true;
+	const SliderBackend previous_backend{ m_moveGen.sliderBackend() };
+	double magic_seconds{};
 
-				new_state.flipSide();
-				const int eval = minimax(new_state, depth - 1, alpha, beta);
+	std::cout << "slider backend benchmark, perft suite, " << backend_names[previous_backend] << " is used by default" << std::endl;
+	std::cout << "backend            nodes    seconds        nodes/s   speedup" << std::endl;
 
-				//time cutoff for iterative deepening
-				if (m_stopSearch)
-				{
-					return state.whiteToMove() ? INT_MAX : INT_MIN;
-				}
+	for (std::size_t i{}; i < backends.size(); i++)
+	{
+		if (!m_moveGen.setSliderBackend(backends[i]))
+		{
+			std::cout << std::setw(7) << backend_names[i] << "   not supported on this cpu" << std::endl;
+			continue;
+		}
 
-				if (eval < min_eval)
-				{
-					min_eval = eval;
+		//a wrong table entry would only show up as a wrong perft count, so check every lookup first
+		if (!m_moveGen.verifySliderAttacks())
+		{
+			std::cout << std::setw(7) << backend_names[i] << "   table does not match the ray tracer" << std::endl;
+			continue;
+		}
 
-					if (depth == m_depth)
-					{
-						m_bestMove = move;
-					}
-				}
+		Perft perft{ m_moveGen };
+		std::uint64_t nodes{};
 
-				if (beta > eval)
-				{
-					beta = eval;
-				}
+		const auto start{ std::chrono::steady_clock::now() };
 
-				if (beta <= alpha)
-				{
-					m_prunes++;
-					break;
-				}
-			}
-		}
-		if (anyLegalMoves)
+		for (const PerftPosition& position : perft_suite)
 		{
-			return min_eval;
+			State state{ State::parse_fen(position.fen) };
+			nodes += perft.count(state, position.depth);
 		}
-		else
+
+		const std::chrono::duration<double> duration{ std::chrono::steady_clock::now() - start };
+		const double seconds{ duration.count() };
+
+		if (backends[i] == SliderBackend::MAGIC)
 		{
-			if (kingInCheck(state))
-			{
-				//black checkmate
-				m_mates++;
-				return INT_MAX - depth - 1;
-			}
-			else
-			{
-				//black stalemate
-				return 0;
-			}
+			magic_seconds = seconds;
 		}
+
+		std::cout << std::setw(7) << backend_names[i]
+			<< std::setw(17) << nodes
+			<< std::setw(11) << std::fixed << std::setprecision(3) << seconds
+			<< std::setw(15) << static_cast<std::uint64_t>(nodes / std::max(seconds, 0.001))
+			<< std::setw(10) << std::setprecision(2) << magic_seconds / std::max(seconds, 0.001) << std::endl;
 	}
+
+	m_moveGen.setSliderBackend(previous_backend);
 }
 
-void Engine::iterativeMinimax(const State& state)
+std::uint64_t Engine::perftCopyMake(const State& state, const std::uint32_t depth, std::vector<MoveList>& lists) const
 {
-	std::uint32_t depth{ 1 };
-	m_searchStartTime = std::chrono::high_resolution_clock::now();
-	m_timeCheckCount = 0;
-	m_stopSearch = false;
+	if (depth == 0)
+	{
+		return 1;
+	}
+
+	MoveList& list{ lists[depth] };
+	list.clear();
+	m_moveGen.generateMoves(state, list);
 
-	while (!m_stopSearch)
+	std::uint64_t nodes{};
+
+	for (const Move& move : list.moves())
 	{
-		m_depth = depth;
-		minimax(m_state, depth, INT_MIN, INT_MAX);
-		m_depthSearched = depth; //TODO: fix these vars there should only be one
-		depth++;
+		State new_state{ state };
+		UndoInfo undo;
 
-		if (!m_stopSearch)
-		{
-			m_bestMoveFinal = m_bestMove;
-		}
+		new_state.makeMove(move, undo);
+		new_state.flipSide();
+		nodes += perftCopyMake(new_state, depth - 1, lists);
+	}
+
+	return nodes;
+}
+
+std::uint64_t Engine::perftMakeUnmake(State& state, const std::uint32_t depth, std::vector<MoveList>& lists) const
+{
+	if (depth == 0)
+	{
+		return 1;
+	}
+
+	MoveList& list{ lists[depth] };
+	list.clear();
+	m_moveGen.generateMoves(state, list);
+
+	std::uint64_t nodes{};
+	UndoInfo undo;
+
+	for (const Move& move : list.moves())
+	{
+		state.makeMove(move, undo);
+		state.flipSide();
+		nodes += perftMakeUnmake(state, depth - 1, lists);
+		state.flipSide();
+		state.unmakeMove(move, undo);
 	}
+
+	return nodes;
 }
 
 void Engine::step(const bool engine_side_white, const bool flip_board, const std::uint32_t depth)
 {
 	m_state.printBoard(flip_board, RF::no_sqr);
-	m_depth = depth;
 
 	while (true)
 	{
@@ -253,16 +440,14 @@ void Engine::step(const bool engine_side_white, const bool flip_board, const std
 				{
 					if (inputAndParseMove(list, move))
 					{
-						State new_state{ m_state };
-						new_state.printBoard(flip_board, m_moveSource);
+						m_state.printBoard(flip_board, m_moveSource);
 						move.print();
 
-						if (makeMove(move, new_state))
-						{
-							m_state = new_state;
-							m_moveSource = move.source();
-							break;
-						}
+						//the list only holds legal moves so anything found in it can be played
+						UndoInfo undo;
+						m_state.makeMove(move, undo);
+						m_moveSource = move.source();
+						break;
 					}
 
 					std::cout << "move does not exist" << std::endl;
@@ -272,8 +457,17 @@ void Engine::step(const bool engine_side_white, const bool flip_board, const std
 			{
 				//engine move
 				std::cout << "thinking" << std::endl;
-				iterativeMinimax(m_state);
-				makeMove(m_bestMoveFinal, m_state);
+				iterativeMinimax(m_state, depth);
+
+				//checkmate or stalemate, there is nothing to play
+				if (!m_bestMoveFinal.data())
+				{
+					std::cout << "no legal moves" << std::endl;
+					return;
+				}
+
+				UndoInfo undo;
+				m_state.makeMove(m_bestMoveFinal, undo);
 
 				m_moveSource = m_bestMoveFinal.source();
 			}
@@ -284,8 +478,17 @@ void Engine::step(const bool engine_side_white, const bool flip_board, const std
 			{
 				//engine move
 				std::cout << "thinking" << std::endl;
-				iterativeMinimax(m_state);
-				makeMove(m_bestMoveFinal, m_state);
+				iterativeMinimax(m_state, depth);
+
+				//checkmate or stalemate, there is nothing to play
+				if (!m_bestMoveFinal.data())
+				{
+					std::cout << "no legal moves" << std::endl;
+					return;
+				}
+
+				UndoInfo undo;
+				m_state.makeMove(m_bestMoveFinal, undo);
 
 				m_moveSource = m_bestMoveFinal.source();
 			}
@@ -300,16 +503,14 @@ void Engine::step(const bool engine_side_white, const bool flip_board, const std
 				{
 					if (inputAndParseMove(list, move))
 					{
-						State new_state{ m_state };
-						new_state.printBoard(flip_board, m_moveSource);
+						m_state.printBoard(flip_board, m_moveSource);
 						move.print();
 
-						if (makeMove(move, new_state))
-						{
-							m_state = new_state;
-							m_moveSource = move.source();
-							break;
-						}
+						//the list only holds legal moves so anything found in it can be played
+						UndoInfo undo;
+						m_state.makeMove(move, undo);
+						m_moveSource = move.source();
+						break;
 					}
 
 					std::cout << "move does not exist" << std::endl;
@@ -326,53 +527,35 @@ void Engine::step(const bool engine_side_white, const bool flip_board, const std
 		std::cout << "move: ";
 		m_bestMoveFinal.print();
 
+		const SearchStats stats{ searchStats() };
+
 		std::cout << "depth: " << m_depthSearched << std::endl;
-		std::cout << "nodes: " << m_nodes << std::endl;
-		std::cout << "evaluations: " << m_evaluations << std::endl;
-		std::cout << "prunes: " << m_prunes << std::endl;
-		std::cout << "mates: " << m_mates << std::endl;
+		std::cout << "pv:";
+
+		for (const Move move : m_principalVariation.moves())
+		{
+			std::cout << ' ' << move.toString();
+		}
+
+		std::cout << std::endl;
+		std::cout << "threads: " << threadCount() << std::endl;
+		std::cout << "nodes: " << stats.nodes << std::endl;
+		std::cout << "quiescence nodes: " << stats.quiescenceNodes << std::endl;
+		std::cout << "evaluations: " << stats.evaluations << std::endl;
+		std::cout << "prunes: " << stats.prunes << std::endl;
+		std::cout << "mates: " << stats.mates << std::endl;
+		std::cout << "tt hits: " << stats.ttHits << std::endl;
+		std::cout << "tt cutoffs: " << stats.ttCutoffs << std::endl;
+		std::cout << "null move cutoffs: " << stats.nullMoveCutoffs << std::endl;
+		std::cout << "aspiration fails: " << stats.aspirationFailLows + stats.aspirationFailHighs << " of " << stats.aspirationSearches << std::endl;
 		std::cout << duration.count() << " seconds" << std::endl;
 
-		m_nodes = 0;
-		m_evaluations = 0;
-		m_prunes = 0;
-		m_mates = 0;
 		m_depthSearched = 0;
 
 		m_state.flipSide();
 	}
 }
 
-bool Engine::kingInCheck(const State& state) const
-{
-	if (state.whiteToMove())
-	{
-		const std::size_t king_square = state.positions()[KING].find_1lsb();
-
-		if (king_square == SIZE_MAX)
-		{
-			return true;
-		}
-		else
-		{
-			return m_moveGen.isSquareAttacked(state, king_square, Color::WHITE);
-		}
-	}
-	else
-	{
-		const std::size_t king_square = state.positions()[BKING].find_1lsb();
-
-		if (king_square == SIZE_MAX)
-		{
-			return true;
-		}
-		else
-		{
-			return m_moveGen.isSquareAttacked(state, king_square, Color::BLACK);
-		}
-	}
-}
-
 void Engine::printBoard(const bool flipped) const
 {
 	m_state.printBoard(flipped, RF::no_sqr);
@@ -473,128 +656,4 @@ std::size_t Engine::squareToIndex(std::string_view square)
 	const std::size_t file{ static_cast<std::size_t>(square[0] - 'a') };
 
 	return rank * RANK_MAX + file;
-}
-
-bool Engine::makeMove(const Move move, State& state) const
-{
-	state.setEnpassantSquare(no_sqr);
-
-	//unpack
-	const std::size_t source = move.source();
-	const std::size_t target = move.target();
-	const Piece piece = move.piece();
-	const bool promoted = move.promoted();
-	const bool capture = move.capture();
-	const bool double_pawn = move.doublePawnPush();
-	const bool enpassant = move.enpassant();
-	const bool castle = move.castle();
-
-	//if statements in most efficient order for least number of branching
-	if (castle)//TODO: remove moveQuiet and moveCapture they have unnessesary loops and checks. make template function
-	{
-		if (state.whiteToMove())
-		{
-			state.moveQuiet(KING, e1, source);
-
-			if (source == g1)
-			{
-				state.moveQuiet(ROOK, h1, f1);
-				state.setCastleRights(h1);
-			}
-			else
-			{
-				state.moveQuiet(ROOK, a1, d1);
-				state.setCastleRights(a1);
-			}
-		}
-		else
-		{
-			state.moveQuiet(BKING, e8, source);
-
-			if (source == g8)
-			{
-				state.moveQuiet(BROOK, h8, f8);
-				state.setCastleRights(h8);
-			}
-			else
-			{
-				state.moveQuiet(BROOK, a8, d8);
-				state.setCastleRights(a8);
-			}
-		}
-	}
-	else
-	{
-		state.setCastleRights(source);
-		state.setCastleRights(target);
-
-		//captures
-		if (capture)
-		{
-			if (promoted)
-			{
-				state.popPiece(state.whiteToMove() ? Piece::PAWN : Piece::BPAWN, source);
-				state.popSquare(target);
-				state.setPiece(piece, target);
-			}
-			else if (enpassant)//TODO: maybe make move enpassant and other compile time known piece movers
-			{
-				if (state.whiteToMove())
-				{
-					state.popPiece(Piece::PAWN, source);
-					state.popPiece(Piece::BPAWN, target + 8);
-					state.setPiece(Piece::PAWN, target);
-				}
-				else
-				{
-					state.popPiece(Piece::BPAWN, source);
-					state.popPiece(Piece::PAWN, target - 8);
-					state.setPiece(Piece::BPAWN, target);
-				}
-			}
-			else
-			{
-				state.moveCapture(piece, source, target);
-			}
-		}
-		//quiets
-		else
-		{
-			if (double_pawn)
-			{//TODO: we know its a pawn we dont have to loop through pieces
-				state.moveQuiet(state.whiteToMove() ? PAWN : BPAWN, source, target);
-				state.setEnpassantSquare(state.whiteToMove() ? source - 8 : source + 8);
-			}
-			else if (promoted)
-			{
-				state.popPiece(state.whiteToMove() ? Piece::PAWN : Piece::BPAWN, source);
-				state.setPiece(piece, target);
-			}
-			else
-			{
-				state.moveQuiet(piece, source, target);
-			}
-		}
-	}
-
-	if (kingInCheck(state))
-	{
-		return false;
-	}
-	else
-	{
-		return true;
-	}
-	
-}
-
-
-
-
-
-
-
-
-
-
-
+}
\ No newline at end of file
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "MoveGen.h"
+#include "TranspositionTable.h"
+#include "SearchThread.h"
+#include "Perft.h"
+#include "ParallelPerft.h"
+#include "PerftTable.h"
 #include "BitBoard.h"
 #include "ChessConstants.hpp"
 #include <string>
@@ -8,6 +13,10 @@
 #include <cstddef>
 #include <algorithm>
 #include <chrono>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
 
 using namespace std::literals::string_literals;
 
@@ -15,24 +24,21 @@ class Engine
 {
 private:
 	MoveGen m_moveGen;
+	TranspositionTable m_transpositionTable;
 
-	State m_state;
-	Move m_bestMove;
-	Move m_bestMoveFinal;
+	//search threads and their per ply stacks only exist while iterativeMinimax runs, an idle engine holds just the count
+	std::size_t m_threadCount;
+	std::atomic<bool> m_stopSearch;
 
-	std::uint32_t m_depth;
+	//summed over every thread of the last search
+	SearchStats m_searchStats;
 
-	bool m_stopSearch;
-	int m_timeCheckCount;
-	std::chrono::steady_clock::time_point m_searchStartTime;
+	State m_state;
+	Move m_bestMoveFinal;
+	MoveList m_principalVariation;
 
 	std::uint32_t m_depthSearched;
-	std::uint32_t m_evaluations;
-	std::uint32_t m_nodes;
-	std::uint32_t m_prunes;
-	std::uint32_t m_mates;
 	std::size_t m_moveSource;
-	std::chrono::duration<double> m_seconds;
 
 public:
 	Engine();
@@ -41,15 +47,43 @@ public:
 
 	void setState(std::string_view fen);
 
+	void setHashSize(const std::size_t megabytes);
+
+	void setThreadCount(const std::size_t thread_count);
+
+	std::size_t threadCount() const;
+
 	void step(const bool engine_side_white, const bool flip_board, const std::uint32_t depth);
 
 	void printBoard(const bool flipped) const;
 
-	int evaluate(const State& state);
+	void iterativeMinimax(const State& state, const std::uint32_t max_depth = MAX_MINIMAX_DEPTH, const bool time_limited = true);
+
+	SearchStats searchStats() const;
 
-	int minimax(const State& state, const std::uint32_t depth, int alpha, int beta);
+	//searches the current position to a fixed depth with 1, 2, 4, 8 and 16 threads
+	void timeToDepthReport(const std::uint32_t depth);
 
-	void iterativeMinimax(const State& state);
+	//fixed depth search of every perft suite position, prints the node count and how often the aspiration window failed
+	void searchBenchmark(const std::uint32_t depth);
+
+	//times copy make against make unmake with a perft to the given depth on every perft suite position
+	void makeMoveBenchmark(const std::uint32_t depth);
+
+	//perft divide on the given position, prints the leaf count below every root move
+	void perft(std::string_view fen, const std::uint32_t depth) const;
+
+	//checks the move generator against the known perft results, returns false on any mismatch
+	bool perftSuite() const;
+
+	//fixed depth search of kiwipete on one thread, returns false if the search itself did any heap allocation, or if the build has no ALLOCATION_CHECK
+	bool allocationCheck(const std::uint32_t depth);
+
+	//hashed perft on 1, 2, 4 ... threads up to the core count, prints the thread scaling and the table hit rate
+	void parallelPerftReport(std::string_view fen, const std::uint32_t depth) const;
+
+	//times the perft suite with magic and, when the cpu supports it, PEXT slider lookups
+	void sliderBackendBenchmark();
 
 	void printAllBoardAttacks(Color C) const;
 
@@ -57,7 +91,9 @@ public:
 
 	static std::size_t squareToIndex(std::string_view square);
 
-	bool makeMove(const Move move, State& state) const;
+private:
+	//both count the same leaves, one copies the state for every move and the other plays and takes back in place
+	std::uint64_t perftCopyMake(const State& state, const std::uint32_t depth, std::vector<MoveList>& lists) const;
 
-	bool kingInCheck(const State& state) const;
+	std::uint64_t perftMakeUnmake(State& state, const std::uint32_t depth, std::vector<MoveList>& lists) const;
 };
\ No newline at end of file
@@ -0,0 +1,249 @@
+#include "MagicFinder.h"
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <unordered_set>
+
+MagicFinder::MagicFinder()
+	: m_squares(), m_nextSquare()
+{
+	const PreGen& pre_gen{ PreGen::instance() };
+
+	for (std::size_t i{}; i < m_squares.size(); i++)
+	{
+		MagicSquare& magic_square{ m_squares[i] };
+		const bool bishop{ i < MAX_BOARD_POSITIONS };
+
+		magic_square.piece = bishop ? Piece::BISHOP : Piece::ROOK;
+		magic_square.square = i % MAX_BOARD_POSITIONS;
+		magic_square.mask = bishop ? pre_gen.bishopRelevantBits()[magic_square.square].board() : pre_gen.rookRelevantBits()[magic_square.square].board();
+		magic_square.magic = bishop ? pregen::bishop_magics[magic_square.square] : pregen::rook_magics[magic_square.square];
+		magic_square.shift = bishop ? pregen::bishop_shifts[magic_square.square] : pregen::rook_shifts[magic_square.square];
+		magic_square.trials = 0;
+
+		const std::size_t bit_count{ static_cast<std::size_t>(std::popcount(magic_square.mask)) };
+		std::unordered_set<std::uint64_t> distinct_attacks;
+
+		for (const BitBoard& occupancy : PreGen::createOccupancies(magic_square.mask, bit_count, single_bit << bit_count))
+		{
+			const BitBoard attack{ bishop ? pre_gen.createSliderAttack<Piece::BISHOP>(magic_square.square, occupancy) : pre_gen.createSliderAttack<Piece::ROOK>(magic_square.square, occupancy) };
+
+			magic_square.occupancies.push_back(occupancy.board());
+			magic_square.attacks.push_back(attack.board());
+			distinct_attacks.insert(attack.board());
+		}
+
+		magic_square.minBits = static_cast<std::uint32_t>(std::bit_width(distinct_attacks.size() - 1));
+	}
+}
+
+void MagicFinder::run(const double seconds, const std::size_t thread_count)
+{
+	const std::size_t threads{ std::max<std::size_t>(thread_count, 1) };
+
+	std::array<std::uint32_t, MAX_BOARD_POSITIONS * 2> shifts_before{};
+	for (std::size_t i{}; i < m_squares.size(); i++)
+	{
+		shifts_before[i] = m_squares[i].shift;
+	}
+
+	const std::size_t size_before{ tableSize() };
+
+	//every square gets the same share of the time, so all of them finish together
+	const std::chrono::duration<double> square_time{ seconds * threads / m_squares.size() };
+
+	std::cout << "magic search, " << threads << " threads, " << seconds << " seconds" << std::endl;
+
+	m_nextSquare.store(0);
+	std::vector<std::thread> helpers;
+	helpers.reserve(threads - 1);
+
+	for (std::size_t id{ 1 }; id < threads; id++)
+	{
+		helpers.emplace_back([this, id, square_time]() { worker(id, square_time); });
+	}
+
+	worker(0, square_time);
+
+	for (auto& helper : helpers)
+	{
+		helper.join();
+	}
+
+	std::uint64_t trials{};
+	std::cout << "square   piece   bits   trials" << std::endl;
+
+	for (std::size_t i{}; i < m_squares.size(); i++)
+	{
+		const MagicSquare& magic_square{ m_squares[i] };
+		trials += magic_square.trials;
+
+		if (magic_square.magic == 0)
+		{
+			std::cout << std::setw(6) << index_to_rf[magic_square.square] << std::setw(8) << (magic_square.piece == Piece::BISHOP ? "bishop" : "rook") << "   no magic found" << std::endl;
+		}
+		else if (magic_square.shift != shifts_before[i])
+		{
+			std::cout << std::setw(6) << index_to_rf[magic_square.square] << std::setw(8) << (magic_square.piece == Piece::BISHOP ? "bishop" : "rook")
+				<< std::setw(4) << 64 - shifts_before[i] << "->" << 64 - magic_square.shift
+				<< std::setw(9) << magic_square.trials << std::endl;
+		}
+	}
+
+	std::cout << trials << " trials, slider table " << size_before << " -> " << tableSize() << " entries ("
+		<< size_before * sizeof(BitBoard) / 1024 << " KB -> " << tableSize() * sizeof(BitBoard) / 1024 << " KB)" << std::endl;
+}
+
+bool MagicFinder::writeHeader(std::string_view path) const
+{
+	for (const MagicSquare& magic_square : m_squares)
+	{
+		if (magic_square.magic == 0)
+		{
+			std::cout << "not writing " << path << ", some squares have no magic" << std::endl;
+			return false;
+		}
+	}
+
+	std::ofstream file{ std::string(path) };
+
+	if (!file)
+	{
+		std::cout << "can not open " << path << std::endl;
+		return false;
+	}
+
+	const auto write_array = [&](std::string_view type, std::string_view name, const std::size_t first, const bool shifts)
+	{
+		file << "\tconstexpr std::array<" << type << ", 64> " << name << " = {\n";
+
+		for (std::size_t i{ first }; i < first + MAX_BOARD_POSITIONS; i++)
+		{
+			file << "\t\t" << (shifts ? m_squares[i].shift : m_squares[i].magic) << (i + 1 < first + MAX_BOARD_POSITIONS ? ",\n" : "\n");
+		}
+
+		file << "\t};\n";
+	};
+
+	file << "#pragma once\n#include <cstdint>\n#include <cstddef>\n#include <array>\n\n";
+	file << "//written by ChessConsole.exe magics, the slider tables in PreGen.cpp are built from these at compile time\n";
+	file << "namespace pregen\n{\n";
+	write_array("std::uint64_t", "bishop_magics", 0, false);
+	file << "\n";
+	write_array("std::uint64_t", "rook_magics", MAX_BOARD_POSITIONS, false);
+	file << "\n\t//the index is the top 64 - shift bits of the product, a square can use fewer bits than its mask when occupancies with the same attacks share an entry\n";
+	write_array("std::uint32_t", "bishop_shifts", 0, true);
+	file << "\n";
+	write_array("std::uint32_t", "rook_shifts", MAX_BOARD_POSITIONS, true);
+	file << "\n\t//entries in the magic slider table, every square owns 1 << (64 - shift) of them\n";
+	file << "\tconstexpr std::size_t slider_table_size = " << tableSize() << ";\n";
+	file << "}";
+
+	std::cout << "wrote " << path << std::endl;
+
+	return true;
+}
+
+std::size_t MagicFinder::tableSize() const
+{
+	std::size_t table_size{};
+
+	for (const MagicSquare& magic_square : m_squares)
+	{
+		table_size += single_bit << (MAX_BOARD_POSITIONS - magic_square.shift);
+	}
+
+	return table_size;
+}
+
+void MagicFinder::worker(const std::size_t id, const std::chrono::duration<double> square_time)
+{
+	//every thread draws from its own stream so no state is shared while searching
+	Random rng{ static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) + id };
+
+	for (std::size_t i{ m_nextSquare.fetch_add(1) }; i < m_squares.size(); i = m_nextSquare.fetch_add(1))
+	{
+		const auto deadline{ std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(square_time) };
+		searchSquare(m_squares[i], rng, deadline);
+	}
+}
+
+void MagicFinder::searchSquare(MagicSquare& magic_square, Random& rng, const std::chrono::steady_clock::time_point deadline) const
+{
+	const std::uint32_t relevant_bits{ static_cast<std::uint32_t>(std::popcount(magic_square.mask)) };
+
+	std::vector<std::uint64_t> table(single_bit << relevant_bits);
+	std::vector<std::uint32_t> epochs(single_bit << relevant_bits);
+	std::uint32_t epoch{};
+
+	//a magic that does not fit its mask any more has to be found again at full size before it can shrink
+	if (magic_square.magic == 0 || !tryMagic(magic_square, magic_square.magic, static_cast<std::uint32_t>(MAX_BOARD_POSITIONS) - magic_square.shift, table, epochs, epoch))
+	{
+		magic_square.magic = 0;
+		magic_square.shift = static_cast<std::uint32_t>(MAX_BOARD_POSITIONS) - relevant_bits;
+	}
+
+	while (std::chrono::steady_clock::now() < deadline)
+	{
+		const std::uint32_t current_bits{ static_cast<std::uint32_t>(MAX_BOARD_POSITIONS) - magic_square.shift };
+		const std::uint32_t bits{ magic_square.magic ? current_bits - 1 : current_bits };
+
+		if (bits < magic_square.minBits)
+		{
+			return;
+		}
+
+		//the clock is only read between batches
+		for (std::size_t i{}; i < MAGIC_TRIAL_BATCH; i++)
+		{
+			const std::uint64_t magic{ rng.next_uint64_minbits() };
+
+			//the index comes from the top of the product, when that holds too few bits the magic almost never works
+			if (std::popcount((magic_square.mask * magic) & 0xFF00000000000000) < 6)
+			{
+				continue;
+			}
+
+			magic_square.trials++;
+
+			if (tryMagic(magic_square, magic, bits, table, epochs, epoch))
+			{
+				magic_square.magic = magic;
+				magic_square.shift = static_cast<std::uint32_t>(MAX_BOARD_POSITIONS) - bits;
+				break;
+			}
+		}
+	}
+}
+
+bool MagicFinder::tryMagic(const MagicSquare& magic_square, const std::uint64_t magic, const std::uint32_t bits, std::vector<std::uint64_t>& table, std::vector<std::uint32_t>& epochs, std::uint32_t& epoch)
+{
+	//entries stamped with an older epoch count as empty, so the table never has to be cleared between trials
+	if (++epoch == 0)
+	{
+		std::fill(epochs.begin(), epochs.end(), 0);
+		epoch = 1;
+	}
+
+	const std::uint32_t shift{ static_cast<std::uint32_t>(MAX_BOARD_POSITIONS) - bits };
+
+	for (std::size_t i{}; i < magic_square.occupancies.size(); i++)
+	{
+		const std::size_t index{ static_cast<std::size_t>((magic_square.occupancies[i] * magic) >> shift) };
+
+		if (epochs[index] != epoch)
+		{
+			epochs[index] = epoch;
+			table[index] = magic_square.attacks[i];
+		}
+		else if (table[index] != magic_square.attacks[i])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
\ No newline at end of file
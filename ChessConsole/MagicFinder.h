@@ -0,0 +1,58 @@
+#pragma once
+
+#include "PreGen.h"
+#include "Random.h"
+#include "ChessConstants.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <string_view>
+
+//offline search for denser magic numbers, every square starts from the magic in PregeneratedMagics.hpp and tries to use one index bit less
+class MagicFinder
+{
+private:
+	//one square of one slider, with every occupancy of its mask and the attack each one has to map to
+	struct MagicSquare
+	{
+		Piece piece;
+		std::size_t square;
+		std::uint64_t mask;
+		std::vector<std::uint64_t> occupancies;
+		std::vector<std::uint64_t> attacks;
+
+		//fewer index bits than this can not hold every distinct attack set
+		std::uint32_t minBits;
+
+		std::uint64_t magic;
+		std::uint32_t shift;
+		std::uint64_t trials;
+	};
+
+	//bishops first then rooks, the same order as the slider table
+	std::array<MagicSquare, MAX_BOARD_POSITIONS * 2> m_squares;
+	std::atomic<std::size_t> m_nextSquare;
+
+public:
+	MagicFinder();
+
+	//searches every square on thread_count threads for about the given time, then prints what shrank
+	void run(const double seconds, const std::size_t thread_count);
+
+	//writes a replacement PregeneratedMagics.hpp with the magics and shifts found
+	bool writeHeader(std::string_view path) const;
+
+	//entries the magic slider table needs with the current shifts
+	std::size_t tableSize() const;
+
+private:
+	void worker(const std::size_t id, const std::chrono::duration<double> square_time);
+
+	void searchSquare(MagicSquare& magic_square, Random& rng, const std::chrono::steady_clock::time_point deadline) const;
+
+	//true when every occupancy either gets its own entry or shares one with an occupancy that has the same attacks
+	static bool tryMagic(const MagicSquare& magic_square, const std::uint64_t magic, const std::uint32_t bits, std::vector<std::uint64_t>& table, std::vector<std::uint32_t>& epochs, std::uint32_t& epoch);
+};
\ No newline at end of file
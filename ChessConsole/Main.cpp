@@ -4,16 +4,17 @@ If you are the Cherno reviewing this first of all Thanks, and second I wan't to
 
 I use const and constexpr whenever possible. I try to avoid "magic numbers", instead creating a header file called ChessConstants 
 to store every reusable number. I tried my best to use the correct data type for every scenario, using std::uint32_t whenever I 
-dont need negative numbers, and std::size_t whenever I'm accessing an array or inside a for loop. The entire code runs on the stack. 
+dont need negative numbers, and std::size_t whenever I'm accessing an array or inside a for loop. 
 Finally, I make use of the mostmodern c++ featurs and try to use the most modern approach.
 
 The only thing wrong with the code is I was very inconsistent with my naming convention. For some reason, I kept switchingback
 and forth between snake-case and camel-case. I honestly don't know what I was thinking there seems to be no reason why I used
 one over the other, but hey it is old code.
 
-I dont know if only using the stack was good or bad because it uses over 2.3 megabytes of stack, but I wanted the code to run as fast as possible,
-and most of that data is used up by the pregenerated moves which needs to be accessed millions of times a second. Because of that
-I had to give my project more than the default stack reserve, I gave it 4 megabytes.
+The pregenerated moves used to be 2.3 megabytes of stack, which needed a 4 megabyte stack reserve. They are now built by the compiler
+into read-only memory and shared by every Engine in the process, and the default stack reserve is enough. An idle Engine takes
+about 3 kilobytes plus its hash table. The search threads, each with a few hundred kilobytes of per ply move lists, are only
+allocated while a search runs and are freed when it returns.
 */
 
 
@@ -93,10 +94,9 @@ bq - black queens side castle
 wk - white kings side castle
 wq - white queens side castle
 
-inside ChessConstants.hpp the constexpr bool USING_PREGENERATED_MAGICS is used to tell the program whether to generate new magic numbers
-or use the ones inside PregeneratedMagics.hpp.Generating new magic numbers doesn't take long, especially in release mode but it is 
-redundant because there are only 128 numbers.It generates moves every time it runs because that is 2.3 megabytes of data which would be
-impractical to store.After all, it can generate that in milliseconds.
+Every attack table is built by the compiler from the magic numbers inside PregeneratedMagics.hpp, so starting the program or
+creating an Engine does no table work at all.Running "ChessConsole.exe magics" searches for magic numbers that need fewer index
+bits and writes a new PregeneratedMagics.hpp, which makes the tables smaller the next time the project is built.
 
 Finally, this program is significantly faster in release mode.
 */
@@ -115,11 +115,114 @@ of that game I can't seem to. I think there is something wrong with castling bec
 
 
 #include "Engine.h"
+#include "MagicFinder.h"
 #include "ChessConstants.hpp"
+#include <string>
+#include <string_view>
 
-int main()
+int main(int argc, char* argv[])
 {
+	//ChessConsole.exe smp [depth] prints the lazy smp time to depth scaling report
+	if (argc > 1 && std::string_view(argv[1]) == "smp")
+	{
+		const std::uint32_t depth{ argc > 2 ? static_cast<std::uint32_t>(std::stoul(argv[2])) : 7 };
+
+		Engine engine{ start_position_fen };
+		engine.timeToDepthReport(depth);
+		return 0;
+	}
+
+	//ChessConsole.exe search [depth] prints node counts and aspiration window fails on the perft suite positions
+	if (argc > 1 && std::string_view(argv[1]) == "search")
+	{
+		const std::uint32_t depth{ argc > 2 ? static_cast<std::uint32_t>(std::stoul(argv[2])) : 7 };
+
+		Engine engine;
+		engine.searchBenchmark(depth);
+		return 0;
+	}
+
+	//ChessConsole.exe bench [depth] compares copy make against make unmake
+	if (argc > 1 && std::string_view(argv[1]) == "bench")
+	{
+		const std::uint32_t depth{ argc > 2 ? static_cast<std::uint32_t>(std::stoul(argv[2])) : 5 };
+
+		Engine engine;
+		engine.makeMoveBenchmark(depth);
+		return 0;
+	}
+
+	//ChessConsole.exe perft runs the built in suite, ChessConsole.exe perft <fen> <depth> prints a divide of that position
+	if (argc > 1 && std::string_view(argv[1]) == "perft")
+	{
+		Engine engine;
+
+		if (argc < 4)
+		{
+			return engine.perftSuite() ? 0 : 1;
+		}
+
+		//the fen arrives split on spaces unless it was quoted
+		std::string fen{ argv[2] };
+
+		for (int i{ 3 }; i < argc - 1; i++)
+		{
+			fen += ' ';
+			fen += argv[i];
+		}
+
+		engine.perft(fen, static_cast<std::uint32_t>(std::stoul(argv[argc - 1])));
+		return 0;
+	}
+
+	//ChessConsole.exe alloccheck [depth] fails when a search on kiwipete allocates on the heap
+	if (argc > 1 && std::string_view(argv[1]) == "alloccheck")
+	{
+		const std::uint32_t depth{ argc > 2 ? static_cast<std::uint32_t>(std::stoul(argv[2])) : 6 };
+
+		Engine engine;
+		return engine.allocationCheck(depth) ? 0 : 1;
+	}
+
+	//ChessConsole.exe pperft [fen] [depth] prints the thread scaling of the hashed perft, kiwipete to depth 6 by default
+	if (argc > 1 && std::string_view(argv[1]) == "pperft")
+	{
+		std::string fen{ argc > 3 ? argv[2] : tricky_position_fen };
+
+		for (int i{ 3 }; i < argc - 1; i++)
+		{
+			fen += ' ';
+			fen += argv[i];
+		}
+
+		const std::uint32_t depth{ argc > 2 ? static_cast<std::uint32_t>(std::stoul(argv[argc - 1])) : 6 };
+
+		Engine engine;
+		engine.parallelPerftReport(fen, depth);
+		return 0;
+	}
+
+	//ChessConsole.exe sliders compares magic and PEXT slider lookups on the perft suite
+	if (argc > 1 && std::string_view(argv[1]) == "sliders")
+	{
+		Engine engine;
+		engine.sliderBackendBenchmark();
+		return 0;
+	}
+
+	//ChessConsole.exe magics [seconds] [file] searches for denser magic numbers on every core and writes a new PregeneratedMagics.hpp
+	if (argc > 1 && std::string_view(argv[1]) == "magics")
+	{
+		const double seconds{ argc > 2 ? std::stod(argv[2]) : 60.0 };
+		const std::string path{ argc > 3 ? argv[3] : "PregeneratedMagics.hpp" };
+
+		MagicFinder finder;
+		finder.run(seconds, std::max<std::size_t>(std::thread::hardware_concurrency(), 1));
+		return finder.writeHeader(path) ? 0 : 1;
+	}
+
 	//Engine engine{ start_position_fen };
 	Engine engine{ "rnbqkbnr/pppppppp/8/P7/8/8/PPPPPPPP/RNBQKBNR" };
+	engine.setThreadCount(DEFAULT_THREAD_COUNT);
 	engine.step(false, false, 8); 
 }
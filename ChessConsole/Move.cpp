@@ -143,6 +143,17 @@ bool Move::doublePawnPush() const
 	return castle_data;
 }
 
+std::uint32_t Move::data() const
+{
+	return m_data;
+}
+
+bool Move::operator==(const Move& other) const
+{
+	//the ordering score depends on the position the move was generated in, so it is not part of the move
+	return (m_data & ~value_mask) == (other.m_data & ~value_mask);
+}
+
 void Move::print() const
 {
 	const std::size_t source_p{ source() };
@@ -155,8 +166,39 @@ void Move::print() const
 	std::cout << index_to_rf[source_p] << (capture_p ? "x" : "") << index_to_rf[target_p] << " - pr:" << promoted_p << " ca:" << capture_p << " en:" << enpassant_p << " cas:" << castle_p << std::endl;
 }
 
+std::string Move::toString() const
+{
+	std::string text;
+
+	if (castle())
+	{
+		//castle moves only store where the king lands
+		text += index_to_rf[source() >= a1 ? e1 : e8];
+		text += index_to_rf[source()];
+		return text;
+	}
+
+	text += index_to_rf[source()];
+	text += index_to_rf[target()];
+
+	if (promoted())
+	{
+		//lowercase for both sides, the black pawn is the only piece printed differently on the board
+		text += piece_to_char[(piece() % 6) + Piece::BPAWN];
+	}
+
+	return text;
+}
+
 Move& Move::operator=(const Move& other)
 {
 	m_data = other.m_data;
 	return *this;
+}
+
+Move Move::fromData(const std::uint32_t data)
+{
+	Move move;
+	move.m_data = data;
+	return move;
 }
\ No newline at end of file
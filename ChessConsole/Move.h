@@ -3,6 +3,7 @@
 #include <cstddef>
 #include "ChessConstants.hpp"
 #include <iostream>
+#include <string>
 
 constexpr std::size_t target_shift{ 6 };
 constexpr std::size_t promoted_shift{ 12 };
@@ -67,8 +68,17 @@ public:
 
 	std::uint32_t value() const;
 
+	std::uint32_t data() const;
+
+	bool operator==(const Move& other) const;
+
 	void print() const;
 
+	//long algebraic like e2e4 or e7e8q, castles are written as the king move
+	std::string toString() const;
+
+	static Move fromData(const std::uint32_t data);
+
 	template <Castle C>
 	static Move createCastleMove()
 	{
@@ -3,559 +3,321 @@
 
 
 MoveGen::MoveGen()
-	: m_preGen() {}
+	: m_preGen(PreGen::instance()), m_sliderBackend(SliderBackend::MAGIC), m_sliderLookup(&MoveGen::magicSliderAttack)
+{
+	//quiet on purpose, an Engine is created for every benchmark and thread count, the sliders mode reports which one was picked
+	if (USE_PEXT_WHEN_AVAILABLE)
+	{
+		setSliderBackend(SliderBackend::PEXT);
+	}
 
+#ifdef _DEBUG
+	if (verifySliderAttacks())
+	{
+		std::cout << "Slider Attacks Verified" << std::endl;
+	}
+#endif
+}
 
-void MoveGen::generateMoves(const State& state, MoveList& moveList)
+bool MoveGen::setSliderBackend(const SliderBackend backend)
 {
-	BitBoard board;
+	if (backend == SliderBackend::PEXT && !cpu_has_fast_pext())
+	{
+		return false;
+	}
 
-	for (std::size_t piece{}; piece < PIECE_COUNT; piece++)
+	m_sliderBackend = backend;
+	m_sliderLookup = backend == SliderBackend::PEXT ? &MoveGen::pextSliderAttack : &MoveGen::magicSliderAttack;
+	return true;
+}
+
+SliderBackend MoveGen::sliderBackend() const
+{
+	return m_sliderBackend;
+}
+
+
+void MoveGen::generateMoves(const State& state, MoveList& moveList) const
+{
+	state.whiteToMove() ? generate<Color::WHITE, GenType::ALL_MOVES>(state, moveList) : generate<Color::BLACK, GenType::ALL_MOVES>(state, moveList);
+}
+
+void MoveGen::generateCaptures(const State& state, MoveList& moveList) const
+{
+	state.whiteToMove() ? generate<Color::WHITE, GenType::CAPTURE_MOVES>(state, moveList) : generate<Color::BLACK, GenType::CAPTURE_MOVES>(state, moveList);
+}
+
+void MoveGen::generateQuiets(const State& state, MoveList& moveList) const
+{
+	state.whiteToMove() ? generate<Color::WHITE, GenType::QUIET_MOVES>(state, moveList) : generate<Color::BLACK, GenType::QUIET_MOVES>(state, moveList);
+}
+
+template<Color C, GenType G>
+void MoveGen::generate(const State& state, MoveList& moveList) const
+{
+	constexpr Color them{ other_color(C) };
+	constexpr Piece king{ C == Color::WHITE ? Piece::KING : Piece::BKING };
+
+	//captures mode never looks at empty squares and quiets mode never looks at enemy pieces so nothing is built and thrown away
+	const std::uint64_t empty{ ~state.occupancy()[Occupancy::BOTH].board() };
+	const std::uint64_t targets{ G == GenType::CAPTURE_MOVES ? state.occupancy()[them].board() : G == GenType::QUIET_MOVES ? empty : ~state.occupancy()[C].board() };
+
+	//legality is worked out once per node, checkers limit where pieces can go and pinned pieces can only move along their pin
+	const std::size_t king_square{ state.positions()[king].find_1lsb() };
+	const BitBoard checking_pieces{ checkers<C>(state, king_square) };
+	const std::size_t check_count{ checking_pieces.bitCount() };
+
+	//a single check is answered by taking the checker or stepping in between, a double check only by moving the king
+	std::uint64_t check_mask{ ~std::uint64_t{} };
+
+	if (check_count == 1)
+	{
+		check_mask = m_preGen.betweenMasks()[king_square][checking_pieces.find_1lsb()].board() | checking_pieces.board();
+	}
+
+	if (check_count < 2)
 	{
-		//copy
-		board.setBoard(state.positions()[piece].board());
+		const BitBoard pinned{ pinnedPieces<C>(state, king_square) };
 
-		if (state.whiteToMove())
+		generatePawnMoves<C, G>(state, moveList, king_square, pinned, check_mask);
+		generatePieceMoves<C, C == Color::WHITE ? Piece::KNIGHT : Piece::BKNIGHT>(state, moveList, targets, king_square, pinned, check_mask);
+		generatePieceMoves<C, C == Color::WHITE ? Piece::BISHOP : Piece::BBISHOP>(state, moveList, targets, king_square, pinned, check_mask);
+		generatePieceMoves<C, C == Color::WHITE ? Piece::ROOK : Piece::BROOK>(state, moveList, targets, king_square, pinned, check_mask);
+		generatePieceMoves<C, C == Color::WHITE ? Piece::QUEEN : Piece::BQUEEN>(state, moveList, targets, king_square, pinned, check_mask);
+	}
+
+	//the king is taken off the board so it cannot step back along the line of a slider that is checking it
+	const BitBoard king_occupancy{ state.occupancy()[Occupancy::BOTH].board() & ~(single_bit << king_square) };
+	BitBoard king_attacks{ m_preGen.kingAttacks()[king_square].board() & targets };
+
+	while (king_attacks.board())
+	{
+		const std::size_t target_square{ king_attacks.find_1lsb() };
+		king_attacks.reset(target_square);
+
+		//the king can never step onto an attacked square
+		if (isSquareAttacked<C>(state, target_square, king_occupancy))
 		{
-			//white pawn
-			if (piece == Piece::PAWN)
-			{
-				while (board.board())
-				{
-					const std::size_t source_square{ board.find_1lsb() };
-					const int target_square{ static_cast<int>(source_square) - 8 };
-
-					//white pawn quiet
-					if (target_square > 0 && !state.occupancy()[Occupancy::BOTH].test(target_square))
-					{
-						//promotion
-						if (source_square >= a7 && source_square <= h7)
-						{
-							moveList.addMove<MoveType::QUIET_PROMOTE, Piece::QUEEN>(source_square, target_square, Piece::NO_PIECE);
-							moveList.addMove<MoveType::QUIET_PROMOTE, Piece::ROOK>(source_square, target_square, Piece::NO_PIECE);
-							moveList.addMove<MoveType::QUIET_PROMOTE, Piece::BISHOP>(source_square, target_square, Piece::NO_PIECE);
-							moveList.addMove<MoveType::QUIET_PROMOTE, Piece::KNIGHT>(source_square, target_square, Piece::NO_PIECE);
-						}
-						else
-						{
-							//one square
-							moveList.addMove<MoveType::QUIET, Piece::PAWN>(source_square, target_square, Piece::NO_PIECE);
-
-							//two square
-							if ((source_square >= a2 && source_square <= h2) && !state.occupancy()[Occupancy::BOTH].test(target_square - 8))
-							{
-								moveList.addMove<MoveType::DOUBLE_PAWN, Piece::PAWN>(source_square, target_square - 8, Piece::NO_PIECE);
-							}
-						}
-					}
-
-					//white pawn captures
-					BitBoard attacks{ m_preGen.pawnAttacks()[Color::WHITE][source_square].board() & state.occupancy()[Occupancy::BLACKOCC].board() };
-
-					while (attacks.board())
-					{
-						const std::size_t attack_target{ attacks.find_1lsb() };
-						const Piece target_piece{ state.testPieceType(attack_target) };
-
-						if (source_square >= a7 && source_square <= h7)
-						{
-							//promotion
-							moveList.addMove<MoveType::PROMOTE, Piece::QUEEN>(source_square, attack_target, target_piece);
-							moveList.addMove<MoveType::PROMOTE, Piece::ROOK>(source_square, attack_target, target_piece);
-							moveList.addMove<MoveType::PROMOTE, Piece::BISHOP>(source_square, attack_target, target_piece);
-							moveList.addMove<MoveType::PROMOTE, Piece::KNIGHT>(source_square, attack_target, target_piece);
-
-						}
-						else
-						{
-
-							//non promote
-							moveList.addMove<MoveType::CAPTURE, Piece::PAWN>(source_square, attack_target, target_piece);
-
-						}
-						
-						attacks.reset(attack_target);
-					}
-
-					//enpessant
-					if (state.enpassantSquare() != no_sqr)
-					{
-						const BitBoard pawn_attack{ m_preGen.pawnAttacks()[Color::WHITE][source_square] };
-						const bool enpassant_attack{ pawn_attack.test(state.enpassantSquare()) };
-
-						if (enpassant_attack)
-						{
-							moveList.addMove<MoveType::ENPASSANT, Piece::PAWN>(source_square, state.enpassantSquare(), Piece::PAWN);
-						}
-					}
-
-					board.reset(source_square);
-				}
-			}
+			continue;
+		}
 
-			//white knight
-			if (piece == Piece::KNIGHT)
-			{
-				while (board.board())
-				{
-					const std::size_t source_square{ board.find_1lsb() };
-					BitBoard knight_attacks{ m_preGen.knightAttacks()[source_square].board() & ~state.occupancy()[Color::WHITE].board() };
-
-					while (knight_attacks.board())
-					{
-						const std::size_t target_square{ knight_attacks.find_1lsb() };
-
-						if (state.occupancy()[Color::BLACK].test(target_square))
-						{
-							//captures
-							const Piece target_piece{ state.testPieceType(target_square) };
-							moveList.addMove<MoveType::CAPTURE, Piece::KNIGHT>(source_square, target_square, target_piece);
-						}
-						else
-						{
-							//quite
-							moveList.addMove<MoveType::QUIET, Piece::KNIGHT>(source_square, target_square, Piece::NO_PIECE);
-						}
-
-						knight_attacks.reset(target_square);
-					}
-
-					board.reset(source_square);
-				}
-			}
+		if (state.occupancy()[them].test(target_square))
+		{
+			//captures
+			const Piece target_piece{ state.testPieceType(target_square) };
+			moveList.addMove<MoveType::CAPTURE, king>(king_square, target_square, target_piece);
+		}
+		else
+		{
+			//quite
+			moveList.addMove<MoveType::QUIET, king>(king_square, target_square, Piece::NO_PIECE);
+		}
+	}
 
-			//white bishop
-			if (piece == Piece::BISHOP)
-			{
-				while (board.board())
-				{
-					const std::size_t source_square{ board.find_1lsb() };
-					BitBoard bishop_attacks{ getBishopAttack(source_square, state.occupancy()[Occupancy::BOTH]).board() & ~state.occupancy()[Color::WHITE].board()};
-
-					while (bishop_attacks.board())
-					{
-						const std::size_t target_square{ bishop_attacks.find_1lsb() };
-
-						if (state.occupancy()[Color::BLACK].test(target_square))
-						{
-							//captures
-							const Piece target_piece{ state.testPieceType(target_square) };
-							moveList.addMove<MoveType::CAPTURE, Piece::BISHOP>(source_square, target_square, target_piece);
-						}
-						else
-						{
-							//quite
-							moveList.addMove<MoveType::QUIET, Piece::BISHOP>(source_square, target_square, Piece::NO_PIECE);
-						}
-
-						bishop_attacks.reset(target_square);
-					}
-
-					board.reset(source_square);
-				}
-			}
+	//castle
+	if constexpr (G != GenType::CAPTURE_MOVES)
+	{
+		if (check_count == 0)
+		{
+			generateCastleMoves<C>(state, moveList);
+		}
+	}
+}
 
-			//white rook
-			if (piece == Piece::ROOK)
-			{
-				while (board.board())
-				{
-					const std::size_t source_square{ board.find_1lsb() };
-					BitBoard rook_attacks{ getRookAttack(source_square, state.occupancy()[Occupancy::BOTH]).board() & ~state.occupancy()[Color::WHITE].board() };
-
-					while (rook_attacks.board())
-					{
-						const std::size_t target_square{ rook_attacks.find_1lsb() };
-
-
-						if (state.occupancy()[Color::BLACK].test(target_square))
-						{
-							//captures
-							const Piece target_piece{ state.testPieceType(target_square) };
-							moveList.addMove<MoveType::CAPTURE, Piece::ROOK>(source_square, target_square, target_piece);
-						}
-						else
-						{
-							//quite
-							moveList.addMove<MoveType::QUIET, Piece::ROOK>(source_square, target_square, Piece::NO_PIECE);
-						}
-
-						rook_attacks.reset(target_square);
-					}
-
-					board.reset(source_square);
-				}
-			}
+template<Color C, GenType G>
+void MoveGen::generatePawnMoves(const State& state, MoveList& moveList, const std::size_t king_square, const BitBoard pinned, const std::uint64_t check_mask) const
+{
+	constexpr Color them{ other_color(C) };
+	constexpr Piece pawn{ C == Color::WHITE ? Piece::PAWN : Piece::BPAWN };
 
-			//white queen
-			if (piece == Piece::QUEEN)
-			{
-				while (board.board())
-				{
-					const std::size_t source_square{ board.find_1lsb() };
-					const BitBoard rook_attacks{ getRookAttack(source_square, state.occupancy()[Occupancy::BOTH]).board() };
-					const BitBoard bishop_attacks{ getBishopAttack(source_square, state.occupancy()[Occupancy::BOTH]).board() };
-					BitBoard queen_attacks{ (rook_attacks.board() | bishop_attacks.board()) & ~state.occupancy()[Color::WHITE].board() };
-
-					while (queen_attacks.board())
-					{
-						const std::size_t target_square{ queen_attacks.find_1lsb() };
-
-
-						if (state.occupancy()[Color::BLACK].test(target_square))
-						{
-							//captures
-							const Piece target_piece{ state.testPieceType(target_square) };
-							moveList.addMove<MoveType::CAPTURE, Piece::QUEEN>(source_square, target_square, target_piece);
-						}
-						else
-						{
-							//quite
-							moveList.addMove<MoveType::QUIET, Piece::QUEEN>(source_square, target_square, Piece::NO_PIECE);
-						}
-
-						queen_attacks.reset(target_square);
-					}
-
-					board.reset(source_square);
-				}
-			}
+	//white pawns move towards a8 which is square 0, black pawns towards h1 which is square 63
+	constexpr int up{ C == Color::WHITE ? -8 : 8 };
+	constexpr int up_left{ up - 1 };
+	constexpr int up_right{ up + 1 };
+	constexpr std::uint64_t last_rank{ C == Color::WHITE ? rank_8_mask : rank_1_mask };
+	constexpr std::uint64_t double_push_rank{ C == Color::WHITE ? rank_4_mask : rank_5_mask };
 
-			//white king
-			if (piece == Piece::KING)
-			{
-				while (board.board())
-				{
-					const std::size_t source_square{ board.find_1lsb() };
-					BitBoard king_attacks{ m_preGen.kingAttacks()[source_square].board() & ~state.occupancy()[Color::WHITE].board() };
-
-					while (king_attacks.board())
-					{
-						const std::size_t target_square{ king_attacks.find_1lsb() };
-
-
-						if (state.occupancy()[Color::BLACK].test(target_square))
-						{
-							//captures
-							const Piece target_piece{ state.testPieceType(target_square) };
-							moveList.addMove<MoveType::CAPTURE, Piece::KING>(source_square, target_square, target_piece);
-						}
-						else
-						{
-							//quite
-							moveList.addMove<MoveType::QUIET, Piece::KING>(source_square, target_square, Piece::NO_PIECE);
-						}
-
-						king_attacks.reset(target_square);
-					}
-
-					board.reset(source_square);
-				}
-			}
+	//every pawn is moved at once, the target sets are only split into single moves when they are added to the list
+	const std::uint64_t pawns{ state.positions()[pawn].board() };
+	const std::uint64_t empty{ ~state.occupancy()[Occupancy::BOTH].board() };
+	const std::uint64_t enemies{ state.occupancy()[them].board() };
+
+	const std::uint64_t single_pushes{ shift<up>(pawns) & empty };
+
+	if constexpr (G != GenType::CAPTURE_MOVES)
+	{
+		//a double push has to pass over an empty square, so it starts from the single pushes
+		const std::uint64_t double_pushes{ shift<up>(single_pushes) & empty & double_push_rank };
+
+		addPawnMoves<MoveType::QUIET, pawn, up>(state, moveList, single_pushes & ~last_rank & check_mask, king_square, pinned);
+		addPawnMoves<MoveType::DOUBLE_PAWN, pawn, up + up>(state, moveList, double_pushes & check_mask, king_square, pinned);
+	}
+
+	if constexpr (G != GenType::QUIET_MOVES)
+	{
+		//the edge file is masked off first so a capture never wraps around to the other side of the board
+		const std::uint64_t left_captures{ shift<up_left>(pawns & ~file_a_mask) & enemies & check_mask };
+		const std::uint64_t right_captures{ shift<up_right>(pawns & ~file_h_mask) & enemies & check_mask };
+
+		addPawnMoves<MoveType::QUIET_PROMOTE, pawn, up>(state, moveList, single_pushes & last_rank & check_mask, king_square, pinned);
+		addPawnMoves<MoveType::PROMOTE, pawn, up_left>(state, moveList, left_captures & last_rank, king_square, pinned);
+		addPawnMoves<MoveType::PROMOTE, pawn, up_right>(state, moveList, right_captures & last_rank, king_square, pinned);
+		addPawnMoves<MoveType::CAPTURE, pawn, up_left>(state, moveList, left_captures & ~last_rank, king_square, pinned);
+		addPawnMoves<MoveType::CAPTURE, pawn, up_right>(state, moveList, right_captures & ~last_rank, king_square, pinned);
+
+		//enpessant, attacks are symmetric so the enemy pawn attack from the enpassant square finds our capturing pawns
+		if (state.enpassantSquare() != no_sqr)
+		{
+			BitBoard sources{ m_preGen.pawnAttacks()[them][state.enpassantSquare()].board() & pawns };
 
-			//white castle
-			if (piece == Piece::KING)
+			while (sources.board())
 			{
-				const BitBoard occupancy{ state.occupancy()[Occupancy::BOTH] };
+				const std::size_t source_square{ sources.find_1lsb() };
 
-				//white king side
-				if (state.testCastleRights(Castle::WK))
+				if (isEnpassantLegal<C>(state, source_square, king_square, check_mask))
 				{
-					//path is clear
-					if (!occupancy.test(f1) && !occupancy.test(g1))
-					{
-						//not under attack
-						if (!isSquareAttacked(state, e1, Color::WHITE) && !isSquareAttacked(state, f1, Color::WHITE))
-						{
-							moveList.addCastleMove<Castle::WK>();
-						}
-					}
+					moveList.addMove<MoveType::ENPASSANT, pawn>(source_square, state.enpassantSquare(), Piece::PAWN);
 				}
 
-				//white queen side
-				if (state.testCastleRights(Castle::WQ))
-				{
-					//path is clear
-					if (!occupancy.test(d1) && !occupancy.test(c1) && !occupancy.test(b1))
-					{
-						//not under attack
-						if (!isSquareAttacked(state, e1, Color::WHITE) && !isSquareAttacked(state, c1, Color::WHITE))
-						{
-							moveList.addCastleMove<Castle::WQ>();
-						}
-					}
-				}
+				sources.reset(source_square);
 			}
 		}
+	}
+}
+
+template<MoveType M, Piece P, int D>
+void MoveGen::addPawnMoves(const State& state, MoveList& moveList, const std::uint64_t targets, const std::size_t king_square, const BitBoard pinned) const
+{
+	constexpr Piece queen{ P == Piece::PAWN ? Piece::QUEEN : Piece::BQUEEN };
+	constexpr Piece rook{ P == Piece::PAWN ? Piece::ROOK : Piece::BROOK };
+	constexpr Piece bishop{ P == Piece::PAWN ? Piece::BISHOP : Piece::BBISHOP };
+	constexpr Piece knight{ P == Piece::PAWN ? Piece::KNIGHT : Piece::BKNIGHT };
+
+	BitBoard board{ targets };
+
+	while (board.board())
+	{
+		const std::size_t target_square{ board.find_1lsb() };
+		const std::size_t source_square{ static_cast<std::size_t>(static_cast<int>(target_square) - D) };
+		board.reset(target_square);
+
+		//a pinned pawn can only move along the line between its king and the pinning piece
+		if (pinned.test(source_square) && !m_preGen.lineMasks()[king_square][source_square].test(target_square))
+		{
+			continue;
+		}
+
+		if constexpr (M == MoveType::QUIET_PROMOTE || M == MoveType::PROMOTE)
+		{
+			const Piece target_piece{ M == MoveType::PROMOTE ? state.testPieceType(target_square) : Piece::NO_PIECE };
+
+			moveList.addMove<M, queen>(source_square, target_square, target_piece);
+			moveList.addMove<M, rook>(source_square, target_square, target_piece);
+			moveList.addMove<M, bishop>(source_square, target_square, target_piece);
+			moveList.addMove<M, knight>(source_square, target_square, target_piece);
+		}
+		else if constexpr (M == MoveType::CAPTURE)
+		{
+			moveList.addMove<M, P>(source_square, target_square, state.testPieceType(target_square));
+		}
 		else
 		{
-			//black pawn 
-			if (piece == Piece::BPAWN)
-			{
-				while (board.board())
-				{
+			moveList.addMove<M, P>(source_square, target_square, Piece::NO_PIECE);
+		}
+	}
+}
 
-					const std::size_t source_square = board.find_1lsb();
-					const int target_square{ static_cast<int>(source_square) + 8 };
-
-					//black pawn quite
-					if (target_square < 64 && !state.occupancy()[Occupancy::BOTH].test(target_square))
-					{
-						//black pawn promotion
-						if (source_square >= a2 && source_square <= h2)
-						{
-						
-							if ((source_square >= a7 && source_square <= h7) && !state.occupancy()[Occupancy::BOTH].test(target_square + 8))
-							{
-								moveList.addMove<QUIET_PROMOTE, BQUEEN>(source_square, target_square, Piece::NO_PIECE);
-								moveList.addMove<QUIET_PROMOTE, BROOK>(source_square, target_square, Piece::NO_PIECE);
-								moveList.addMove<QUIET_PROMOTE, BBISHOP>(source_square, target_square, Piece::NO_PIECE);
-								moveList.addMove<QUIET_PROMOTE, BKNIGHT>(source_square, target_square, Piece::NO_PIECE);
-							}
-						}
-						else
-						{
-							//one square
-							moveList.addMove<QUIET, BPAWN>(source_square, target_square, Piece::NO_PIECE);
-
-							//two square
-							if ((source_square >= a7 && source_square <= h7) && !state.occupancy()[Occupancy::BOTH].test(target_square + 8))
-							{
-								moveList.addMove<MoveType::DOUBLE_PAWN, Piece::BPAWN>(source_square, target_square + 8, Piece::NO_PIECE);//TODO: maybe switch to variable because add twice
-							}
-						}
-					}
-
-					//black pawn captures
-					BitBoard attacks{ m_preGen.pawnAttacks()[Color::BLACK][source_square].board() & state.occupancy()[Occupancy::WHITEOCC].board() };
-
-					while (attacks.board())
-					{
-						const std::size_t attack_target{ attacks.find_1lsb() };
-						const Piece target_piece{ state.testPieceType(attack_target) };
-
-						//promotion
-						if (source_square >= a2 && source_square <= h2)
-						{
-							moveList.addMove<MoveType::PROMOTE, Piece::BQUEEN>(source_square, attack_target, target_piece);
-							moveList.addMove<MoveType::PROMOTE, Piece::BROOK>(source_square, attack_target, target_piece);
-							moveList.addMove<MoveType::PROMOTE, Piece::BBISHOP>(source_square, attack_target, target_piece);
-							moveList.addMove<MoveType::PROMOTE, Piece::BKNIGHT>(source_square, attack_target, target_piece);
-						}
-						else
-						{
-							//one square
-							moveList.addMove<MoveType::CAPTURE, Piece::BPAWN>(source_square, attack_target, target_piece);
-						}
-						
-						attacks.reset(attack_target);
-					}
-
-					//enpessant
-					if (state.enpassantSquare() != no_sqr)
-					{
-						const BitBoard pawn_attack{ m_preGen.pawnAttacks()[Color::BLACK][source_square] };
-						const bool enpassant_attack{ pawn_attack.test(state.enpassantSquare()) };
-
-						if (enpassant_attack)
-						{
-							moveList.addMove<MoveType::ENPASSANT, Piece::BPAWN>(source_square, state.enpassantSquare(), Piece::PAWN);
-						}
-					}
-
-					board.reset(source_square);
-				}
-			}
+template<Color C, Piece P>
+void MoveGen::generatePieceMoves(const State& state, MoveList& moveList, const std::uint64_t targets, const std::size_t king_square, const BitBoard pinned, const std::uint64_t check_mask) const
+{
+	constexpr Color them{ other_color(C) };
 
-			//black knight
-			if (piece == Piece::BKNIGHT)
-			{
-				while (board.board())
-				{
-					const std::size_t source_square{ board.find_1lsb() };
-					BitBoard knight_attacks{ m_preGen.knightAttacks()[source_square].board() & ~state.occupancy()[Color::BLACK].board() };
-
-					while (knight_attacks.board())
-					{
-						const std::size_t target_square{ knight_attacks.find_1lsb() };
-						const Piece target_piece{ state.testPieceType(target_square) };
-
-						if (state.occupancy()[Color::WHITE].test(target_square))
-						{
-							//captures
-							moveList.addMove<MoveType::CAPTURE, Piece::BKNIGHT>(source_square, target_square, target_piece);
-						}
-						else
-						{
-							//quite
-							moveList.addMove<MoveType::QUIET, Piece::BKNIGHT>(source_square, target_square, target_piece);
-						}
-
-						knight_attacks.reset(target_square);
-					}
-
-					board.reset(source_square);
-				}
-			}
+	const BitBoard occupancy{ state.occupancy()[Occupancy::BOTH] };
+	BitBoard board{ state.positions()[P] };
 
-			//black bishop
-			if (piece == Piece::BBISHOP)
-			{
-				while (board.board())
-				{
-					const std::size_t source_square{ board.find_1lsb() };
-					BitBoard bishop_attacks{ getBishopAttack(source_square, state.occupancy()[Occupancy::BOTH]).board() & ~state.occupancy()[Color::BLACK].board() };
-
-					while (bishop_attacks.board())
-					{
-						const std::size_t target_square{ bishop_attacks.find_1lsb() };
-
-						if (state.occupancy()[Color::WHITE].test(target_square))
-						{
-							//captures
-							const Piece target_piece{ state.testPieceType(target_square) };
-							moveList.addMove<MoveType::CAPTURE, Piece::BBISHOP>(source_square, target_square, target_piece);
-						}
-						else
-						{
-							//quite
-							moveList.addMove<MoveType::QUIET, Piece::BBISHOP>(source_square, target_square, Piece::NO_PIECE);
-						}
-
-						bishop_attacks.reset(target_square);
-					}
-
-					board.reset(source_square);
-				}
-			}
+	while (board.board())
+	{
+		const std::size_t source_square{ board.find_1lsb() };
+		const BitBoard legal{ pinned.test(source_square) ? check_mask & m_preGen.lineMasks()[king_square][source_square].board() : check_mask };
+		std::uint64_t piece_attacks{};
+
+		if constexpr (P % 6 == Piece::KNIGHT)
+		{
+			piece_attacks = m_preGen.knightAttacks()[source_square].board();
+		}
+		else if constexpr (P % 6 == Piece::BISHOP)
+		{
+			piece_attacks = getBishopAttack(source_square, occupancy).board();
+		}
+		else if constexpr (P % 6 == Piece::ROOK)
+		{
+			piece_attacks = getRookAttack(source_square, occupancy).board();
+		}
+		else
+		{
+			piece_attacks = getBishopAttack(source_square, occupancy).board() | getRookAttack(source_square, occupancy).board();
+		}
 
-			//black rook
-			if (piece == Piece::BROOK)
+		BitBoard attacks{ piece_attacks & targets & legal.board() };
+
+		while (attacks.board())
+		{
+			const std::size_t target_square{ attacks.find_1lsb() };
+
+			if (state.occupancy()[them].test(target_square))
 			{
-				while (board.board())
-				{
-					const std::size_t source_square{ board.find_1lsb() };
-					BitBoard rook_attacks{ getRookAttack(source_square, state.occupancy()[Occupancy::BOTH]).board() & ~state.occupancy()[Color::BLACK].board() };
-
-					while (rook_attacks.board())
-					{
-						const std::size_t target_square{ rook_attacks.find_1lsb() };
-
-						if (state.occupancy()[Color::WHITE].test(target_square))
-						{
-							//captures
-							const Piece target_piece{ state.testPieceType(target_square) };
-							moveList.addMove<MoveType::CAPTURE, Piece::BROOK>(source_square, target_square, target_piece);
-						}
-						else
-						{
-							//quite
-							moveList.addMove<MoveType::QUIET, Piece::BROOK>(source_square, target_square, Piece::NO_PIECE);
-						}
-
-						rook_attacks.reset(target_square);
-					}
-
-					board.reset(source_square);
-				}
+				//captures
+				const Piece target_piece{ state.testPieceType(target_square) };
+				moveList.addMove<MoveType::CAPTURE, P>(source_square, target_square, target_piece);
 			}
-
-			//black queen
-			if (piece == Piece::BQUEEN)
+			else
 			{
-				while (board.board())
-				{
-					const std::size_t source_square{ board.find_1lsb() };
-					const BitBoard rook_attacks{ getRookAttack(source_square, state.occupancy()[Occupancy::BOTH]).board() };
-					const BitBoard bishop_attacks{ getBishopAttack(source_square, state.occupancy()[Occupancy::BOTH]).board() };
-					BitBoard queen_attacks{ (rook_attacks.board() | bishop_attacks.board()) & ~state.occupancy()[Color::BLACK].board() };
-
-					while (queen_attacks.board())
-					{
-						const std::size_t target_square{ queen_attacks.find_1lsb() };
-
-						if (state.occupancy()[Color::WHITE].test(target_square))
-						{
-							//captures
-							const Piece target_piece{ state.testPieceType(target_square) };
-							moveList.addMove<MoveType::CAPTURE, Piece::BQUEEN>(source_square, target_square, target_piece);
-						}
-						else
-						{
-							//quite
-							moveList.addMove<MoveType::QUIET, Piece::BQUEEN>(source_square, target_square, Piece::NO_PIECE);
-						}
-
-						queen_attacks.reset(target_square);
-					}
-
-					board.reset(source_square);
-				}
+				//quite
+				moveList.addMove<MoveType::QUIET, P>(source_square, target_square, Piece::NO_PIECE);
 			}
 
-			//black king
-			if (piece == Piece::BKING)
+			attacks.reset(target_square);
+		}
+
+		board.reset(source_square);
+	}
+}
+
+template<Color C>
+void MoveGen::generateCastleMoves(const State& state, MoveList& moveList) const
+{
+	constexpr Castle king_side{ C == Color::WHITE ? Castle::WK : Castle::BK };
+	constexpr Castle queen_side{ C == Color::WHITE ? Castle::WQ : Castle::BQ };
+
+	//a1 and a8 are the first square of each back rank, the rest of the rank follows in file order
+	constexpr std::size_t back_rank{ C == Color::WHITE ? a1 : a8 };
+
+	const BitBoard occupancy{ state.occupancy()[Occupancy::BOTH] };
+
+	//king side
+	if (state.testCastleRights(king_side))
+	{
+		//path is clear
+		if (!occupancy.test(back_rank + 5) && !occupancy.test(back_rank + 6))
+		{
+			//the king does not pass through or land on an attacked square
+			if (!isSquareAttacked<C>(state, back_rank + 5, occupancy) && !isSquareAttacked<C>(state, back_rank + 6, occupancy))
 			{
-				while (board.board())
-				{
-					const std::size_t source_square{ board.find_1lsb() };
-					BitBoard king_attacks{ m_preGen.kingAttacks()[source_square].board() & ~state.occupancy()[Color::BLACK].board() };
-
-					while (king_attacks.board())
-					{
-						const std::size_t target_square{ king_attacks.find_1lsb() };
-
-						if (state.occupancy()[Color::WHITE].test(target_square))
-						{
-							//captures
-							const Piece target_piece{ state.testPieceType(target_square) };
-							moveList.addMove<MoveType::CAPTURE, Piece::BKING>(source_square, target_square, target_piece);
-						}
-						else
-						{
-							//quite
-							moveList.addMove<MoveType::QUIET, Piece::BKING>(source_square, target_square, Piece::NO_PIECE);
-						}
-
-						king_attacks.reset(target_square);
-					}
-
-					board.reset(source_square);
-				}
+				moveList.addCastleMove<king_side>();
 			}
+		}
+	}
 
-			//black castle
-			if (piece == Piece::BKING)
+	//queen side
+	if (state.testCastleRights(queen_side))
+	{
+		//path is clear
+		if (!occupancy.test(back_rank + 3) && !occupancy.test(back_rank + 2) && !occupancy.test(back_rank + 1))
+		{
+			//the king does not pass through or land on an attacked square
+			if (!isSquareAttacked<C>(state, back_rank + 3, occupancy) && !isSquareAttacked<C>(state, back_rank + 2, occupancy))
 			{
-				const BitBoard occupancy = state.occupancy()[Occupancy::BOTH];
-
-				//black king side
-				if (state.testCastleRights(Castle::BK))
-				{
-					//path is clear
-					if (!occupancy.test(f8) && !occupancy.test(g8))
-					{
-						//not under attack
-						if (!isSquareAttacked(state, e8, Color::BLACK) && !isSquareAttacked(state, f8, Color::BLACK))
-						{
-							moveList.addCastleMove<Castle::BK>();
-						}
-					}
-				}
-
-				//black queen side
-				if (state.testCastleRights(Castle::BQ))
-				{
-					//path is clear
-					if (!occupancy.test(d8) && !occupancy.test(c8) && !occupancy.test(b8))
-					{
-						//not under attack
-						if (!isSquareAttacked(state, e8, Color::BLACK) && !isSquareAttacked(state, c8, Color::BLACK))
-						{
-							moveList.addCastleMove<Castle::BQ>();
-						}
-					}
-				}
+				moveList.addCastleMove<queen_side>();
 			}
 		}
 	}
@@ -564,89 +326,256 @@ void MoveGen::generateMoves(const State& state, MoveList& moveList)
 //color represents defending side
 bool MoveGen::isSquareAttacked(const State& state, const std::size_t square, const Color side) const
 {
-	//white pawn
-	const BitBoard pawn_attack{ m_preGen.pawnAttacks()[Color::BLACK][square] };
-	const BitBoard pawn{ state.positions()[Piece::PAWN] };
-	if ((side == Color::BLACK) && (pawn_attack.board() & pawn.board()))
-	{
-		return true;
-	}
+	return isSquareAttacked(state, square, side, state.occupancy()[Occupancy::BOTH]);
+}
+
+bool MoveGen::isSquareAttacked(const State& state, const std::size_t square, const Color side, const BitBoard occupancy) const
+{
+	return side == Color::WHITE ? isSquareAttacked<Color::WHITE>(state, square, occupancy) : isSquareAttacked<Color::BLACK>(state, square, occupancy);
+}
+
+BitBoard MoveGen::attackersTo(const State& state, const std::size_t square, const BitBoard occupancy) const
+{
+	const std::array<BitBoard, 12>& positions{ state.positions() };
+
+	const std::uint64_t diagonal_sliders{ positions[Piece::BISHOP].board() | positions[Piece::QUEEN].board() | positions[Piece::BBISHOP].board() | positions[Piece::BQUEEN].board() };
+	const std::uint64_t straight_sliders{ positions[Piece::ROOK].board() | positions[Piece::QUEEN].board() | positions[Piece::BROOK].board() | positions[Piece::BQUEEN].board() };
+
+	//every attack is symmetric so looking out from the square finds the pieces looking in,
+	//a black pawn on this square would attack exactly the white pawns that attack it and the other way around
+	return BitBoard{ (m_preGen.pawnAttacks()[Color::BLACK][square].board() & positions[Piece::PAWN].board())
+		| (m_preGen.pawnAttacks()[Color::WHITE][square].board() & positions[Piece::BPAWN].board())
+		| (m_preGen.knightAttacks()[square].board() & (positions[Piece::KNIGHT].board() | positions[Piece::BKNIGHT].board()))
+		| (m_preGen.kingAttacks()[square].board() & (positions[Piece::KING].board() | positions[Piece::BKING].board()))
+		| (getBishopAttack(square, occupancy).board() & diagonal_sliders)
+		| (getRookAttack(square, occupancy).board() & straight_sliders) };
+}
+
+int MoveGen::see(const State& state, const Move move) const
+{
+	const std::array<BitBoard, 12>& positions{ state.positions() };
+	const std::size_t source{ move.source() };
+	const std::size_t target{ move.target() };
+
+	const std::uint64_t diagonal_sliders{ positions[Piece::BISHOP].board() | positions[Piece::QUEEN].board() | positions[Piece::BBISHOP].board() | positions[Piece::BQUEEN].board() };
+	const std::uint64_t straight_sliders{ positions[Piece::ROOK].board() | positions[Piece::QUEEN].board() | positions[Piece::BROOK].board() | positions[Piece::BQUEEN].board() };
+
+	//gain[d] is what the side making capture d wins if the exchange stops right after it
+	std::array<int, 32> gain{};
+	std::size_t d{};
 
-	//black pawn
-	const BitBoard bpawn_attack{ m_preGen.pawnAttacks()[Color::WHITE][square] };
-	const BitBoard bpawn{ state.positions()[Piece::BPAWN] };
-	if ((side == Color::WHITE) && (bpawn_attack.board() & bpawn.board()))
+	const Piece captured{ move.enpassant() ? Piece::PAWN : state.testPieceType(target) };
+	gain[0] = captured == Piece::NO_PIECE ? 0 : see_value[captured % 6];
+
+	//the piece left standing on the target, a promoted pawn is worth its new piece from here on
+	int on_target{ see_value[move.promoted() ? move.piece() % 6 : state.testPieceType(source) % 6] };
+
+	if (move.promoted())
 	{
-		return true;
+		gain[0] += on_target - see_value[Piece::PAWN];
 	}
 
-	//knight
-	const BitBoard knight_attack{ m_preGen.knightAttacks()[square] };
-	const BitBoard knight{ state.positions()[side == Color::WHITE ? Piece::BKNIGHT : Piece::KNIGHT] };
-	if (knight_attack.board() & knight.board())
+	std::uint64_t occupancy{ state.occupancy()[Occupancy::BOTH].board() & ~(single_bit << source) };
+
+	if (move.enpassant())
 	{
-		return true;
+		occupancy &= ~(single_bit << (state.whiteToMove() ? target + 8 : target - 8));
 	}
 
-	//king
-	const BitBoard king_attack{ m_preGen.kingAttacks()[square] };
-	const BitBoard king{ state.positions()[side == Color::WHITE ? Piece::BKING : Piece::KING] };
-	if (king_attack.board() & king.board())
+	std::uint64_t attackers{ attackersTo(state, target, occupancy).board() & occupancy };
+	Color side{ state.whiteToMove() ? Color::BLACK : Color::WHITE };
+
+	while (d + 1 < gain.size())
 	{
-		return true;
+		//least valuable attacker of the side to recapture
+		const std::uint64_t side_attackers{ attackers & state.occupancy()[side].board() };
+
+		if (!side_attackers)
+		{
+			break;
+		}
+
+		std::size_t piece{ Piece::PAWN };
+		std::uint64_t attacker{};
+
+		for (; piece <= Piece::KING; piece++)
+		{
+			attacker = side_attackers & positions[piece + (side == Color::WHITE ? Piece::PAWN : Piece::BPAWN)].board();
+
+			if (attacker)
+			{
+				break;
+			}
+		}
+
+		d++;
+		gain[d] = on_target - gain[d - 1];
+
+		//the side to capture is behind whether it captures or not, so it stops here and the sign of the result is already settled
+		if (std::max(-gain[d - 1], gain[d]) < 0)
+		{
+			d--;
+			break;
+		}
+
+		occupancy ^= attacker & (~attacker + 1);
+
+		//a piece that moves off a line can uncover a slider behind it
+		if (piece == Piece::PAWN || piece == Piece::BISHOP || piece == Piece::QUEEN)
+		{
+			attackers |= getBishopAttack(target, occupancy).board() & diagonal_sliders;
+		}
+
+		if (piece == Piece::ROOK || piece == Piece::QUEEN)
+		{
+			attackers |= getRookAttack(target, occupancy).board() & straight_sliders;
+		}
+
+		attackers &= occupancy;
+		on_target = see_value[piece];
+		side = other_color(side);
 	}
 
-	//bishop
-	const BitBoard bishop_attack{ getBishopAttack(square, state.occupancy()[Occupancy::BOTH])};
-	const BitBoard bishop{ state.positions()[side == Color::WHITE ? Piece::BBISHOP : Piece::BISHOP] };
-	if (bishop_attack.board() & bishop.board())
+	//each side only keeps capturing while it gains, so fold the list back to the first capture
+	while (d)
 	{
-		return true;
+		d--;
+		gain[d] = -std::max(-gain[d], gain[d + 1]);
 	}
 
-	//rook
-	const BitBoard rook_attack{ getRookAttack(square, state.occupancy()[Occupancy::BOTH]) };
-	const BitBoard rook{ state.positions()[side == Color::WHITE ? Piece::BROOK : Piece::ROOK] };
-	if (rook_attack.board() & rook.board())
+	return gain[0];
+}
+
+template<Color C>
+BitBoard MoveGen::attackersTo(const State& state, const std::size_t square, const BitBoard occupancy) const
+{
+	constexpr std::size_t side{ C == Color::WHITE ? Piece::PAWN : Piece::BPAWN };
+	const std::array<BitBoard, 12>& positions{ state.positions() };
+
+	return BitBoard{ (m_preGen.pawnAttacks()[other_color(C)][square].board() & positions[side + Piece::PAWN].board())
+		| (m_preGen.knightAttacks()[square].board() & positions[side + Piece::KNIGHT].board())
+		| (m_preGen.kingAttacks()[square].board() & positions[side + Piece::KING].board())
+		| (getBishopAttack(square, occupancy).board() & (positions[side + Piece::BISHOP].board() | positions[side + Piece::QUEEN].board()))
+		| (getRookAttack(square, occupancy).board() & (positions[side + Piece::ROOK].board() | positions[side + Piece::QUEEN].board())) };
+}
+
+template<Color C>
+bool MoveGen::isSquareAttacked(const State& state, const std::size_t square, const BitBoard occupancy) const
+{
+	return attackersTo<other_color(C)>(state, square, occupancy).board();
+}
+
+template<Color C>
+BitBoard MoveGen::checkers(const State& state, const std::size_t king_square) const
+{
+	return attackersTo<other_color(C)>(state, king_square, state.occupancy()[Occupancy::BOTH]);
+}
+
+template<Color C>
+BitBoard MoveGen::pinnedPieces(const State& state, const std::size_t king_square) const
+{
+	constexpr std::size_t enemy{ C == Color::WHITE ? Piece::BPAWN : Piece::PAWN };
+	const std::array<BitBoard, 12>& positions{ state.positions() };
+	const std::uint64_t own{ state.occupancy()[C].board() };
+	const std::uint64_t occupancy{ state.occupancy()[Occupancy::BOTH].board() };
+
+	//enemy sliders that would see the king on an empty board
+	BitBoard snipers{ attackersTo<other_color(C)>(state, king_square, BitBoard()).board() & (positions[enemy + Piece::BISHOP].board() | positions[enemy + Piece::ROOK].board() | positions[enemy + Piece::QUEEN].board()) };
+
+	std::uint64_t pinned{};
+
+	while (snipers.board())
 	{
-		return true;
+		const std::size_t sniper_square{ snipers.find_1lsb() };
+		const BitBoard blockers{ m_preGen.betweenMasks()[king_square][sniper_square].board() & occupancy };
+
+		//exactly one piece in the way and it is ours
+		if (blockers.bitCount() == 1 && (blockers.board() & own))
+		{
+			pinned |= blockers.board();
+		}
+
+		snipers.reset(sniper_square);
 	}
 
-	//queen
-	const BitBoard queen_attack_b{ getBishopAttack(square, state.occupancy()[Occupancy::BOTH]) };
-	const BitBoard queen_attack_r{ getRookAttack(square, state.occupancy()[Occupancy::BOTH]) };
-	const BitBoard queen_attack{ queen_attack_b.board() | queen_attack_r.board() };
-	const BitBoard queen{ state.positions()[side == Color::WHITE ? Piece::BQUEEN : Piece::QUEEN] };
-	if (queen_attack.board() & queen.board())
+	return BitBoard{ pinned };
+}
+
+template<Color C>
+bool MoveGen::isEnpassantLegal(const State& state, const std::size_t source, const std::size_t king_square, const std::uint64_t check_mask) const
+{
+	constexpr std::size_t enemy{ C == Color::WHITE ? Piece::BPAWN : Piece::PAWN };
+	const std::array<BitBoard, 12>& positions{ state.positions() };
+	const std::size_t target{ state.enpassantSquare() };
+	const std::size_t captured{ C == Color::WHITE ? target + 8 : target - 8 };
+
+	//in check it has to take the pawn that gave check or block a slider on the enpassant square
+	if (!(check_mask & ((single_bit << target) | (single_bit << captured))))
 	{
-		return true;
+		return false;
 	}
 
-	return false;
+	//two pawns leave the same rank at once which can uncover a slider, the same test covers a pinned capturing pawn
+	const BitBoard occupancy{ (state.occupancy()[Occupancy::BOTH].board() & ~(single_bit << source) & ~(single_bit << captured)) | (single_bit << target) };
+
+	//only sliders can be uncovered, the captured pawn is still on the boards so everything else is masked off
+	return !(attackersTo<other_color(C)>(state, king_square, occupancy).board() & (positions[enemy + Piece::BISHOP].board() | positions[enemy + Piece::ROOK].board() | positions[enemy + Piece::QUEEN].board()));
 }
 
 BitBoard MoveGen::getBishopAttack(const std::size_t square, const BitBoard occupancy) const
 {
-	const std::size_t magic_number = static_cast<size_t>(m_preGen.bishopMagics()[square]);
-	const std::uint64_t masked_occupancy = m_preGen.maskRelevantBits<Piece::BISHOP>(occupancy, square);
-	const std::size_t magic_index = (masked_occupancy * magic_number) >> (MAX_BOARD_POSITIONS - m_preGen.bishopBitCount()[square]);
-
-	return m_preGen.bishopAttacks()[square][magic_index];
+	return m_sliderLookup(m_preGen, m_preGen.bishopSliders()[square], occupancy.board());
 }
 
 BitBoard MoveGen::getRookAttack(const std::size_t square, const BitBoard occupancy) const
 {
-	const std::size_t magic_number = static_cast<size_t>(m_preGen.rookMagics()[square]);
-	const std::uint64_t masked_occupancy = m_preGen.maskRelevantBits<Piece::ROOK>(occupancy, square);
-	const std::size_t magic_index = (masked_occupancy * magic_number) >> (MAX_BOARD_POSITIONS - m_preGen.rookBitCount()[square]);
+	return m_sliderLookup(m_preGen, m_preGen.rookSliders()[square], occupancy.board());
+}
+
+BitBoard MoveGen::magicSliderAttack(const PreGen& preGen, const SliderMagic& slider, const std::uint64_t occupancy)
+{
+	return preGen.sliderAttacks()[slider.offset + (((occupancy & slider.mask) * slider.magic) >> slider.shift)];
+}
 
-	return m_preGen.rookAttacks()[square][magic_index];
+BitBoard MoveGen::pextSliderAttack(const PreGen& preGen, const SliderMagic& slider, const std::uint64_t occupancy)
+{
+	return preGen.sliderPextAttacks()[slider.pextOffset + _pext_u64(occupancy, slider.mask)];
+}
+
+bool MoveGen::verifySliderAttacks() const
+{
+	//every subset of every mask, compared against tracing the rays square by square
+	for (std::size_t square{}; square < MAX_BOARD_POSITIONS; square++)
+	{
+		const std::uint64_t bishop_mask{ m_preGen.bishopSliders()[square].mask };
+		const std::uint64_t rook_mask{ m_preGen.rookSliders()[square].mask };
+
+		for (const BitBoard& occupancy : PreGen::createOccupancies(bishop_mask, __popcnt64(bishop_mask), single_bit << __popcnt64(bishop_mask)))
+		{
+			if (getBishopAttack(square, occupancy).board() != m_preGen.createSliderAttack<Piece::BISHOP>(square, occupancy).board())
+			{
+				std::cout << "bishop attack mismatch on " << index_to_rf[square] << std::endl;
+				return false;
+			}
+		}
+
+		for (const BitBoard& occupancy : PreGen::createOccupancies(rook_mask, __popcnt64(rook_mask), single_bit << __popcnt64(rook_mask)))
+		{
+			if (getRookAttack(square, occupancy).board() != m_preGen.createSliderAttack<Piece::ROOK>(square, occupancy).board())
+			{
+				std::cout << "rook attack mismatch on " << index_to_rf[square] << std::endl;
+				return false;
+			}
+		}
+	}
+
+	return true;
 }
 
 template<Color C>
 BitBoard MoveGen::getPawnAttack(const std::size_t square) const
 {
-	return m_preGen.pawnAttacks()[PreGen::indexPawnAttackTable(square, C)];
+	return m_preGen.pawnAttacks()[C][square];
 }
 
 BitBoard MoveGen::getKnightAttack(const std::size_t square) const
@@ -659,7 +588,7 @@ BitBoard MoveGen::getKingAttack(const std::size_t square) const
 	return m_preGen.kingAttacks()[square];
 }
 
-BitBoard MoveGen::getPieceAttack(const std::size_t P, std::size_t square, const State& state)
+BitBoard MoveGen::getPieceAttack(const std::size_t P, std::size_t square, const State& state) const
 {
 	square = square % 6;
 
@@ -690,4 +619,164 @@ BitBoard MoveGen::getPieceAttack(const std::size_t P, std::size_t square, const
 
 		return BitBoard{ bishop_attack.board() | rook_attack.board() };
 	}
-}
\ No newline at end of file
+}
+
+bool MoveGen::isPseudoLegal(const State& state, const Move move) const
+{
+	const bool white{ state.whiteToMove() };
+	const Color side{ white ? Color::WHITE : Color::BLACK };
+	const BitBoard own{ state.occupancy()[white ? Occupancy::WHITEOCC : Occupancy::BLACKOCC] };
+	const BitBoard enemy{ state.occupancy()[white ? Occupancy::BLACKOCC : Occupancy::WHITEOCC] };
+	const BitBoard occupancy{ state.occupancy()[Occupancy::BOTH] };
+
+	const std::size_t source{ move.source() };
+	const std::size_t target{ move.target() };
+
+	//castle moves only store the square the king lands on, same checks as the generator
+	if (move.castle())
+	{
+		switch (source)
+		{
+		case g1:
+			return white && state.testCastleRights(Castle::WK) && !occupancy.test(f1) && !occupancy.test(g1)
+				&& !isSquareAttacked(state, e1, Color::WHITE) && !isSquareAttacked(state, f1, Color::WHITE) && !isSquareAttacked(state, g1, Color::WHITE);
+		case c1:
+			return white && state.testCastleRights(Castle::WQ) && !occupancy.test(d1) && !occupancy.test(c1) && !occupancy.test(b1)
+				&& !isSquareAttacked(state, e1, Color::WHITE) && !isSquareAttacked(state, d1, Color::WHITE) && !isSquareAttacked(state, c1, Color::WHITE);
+		case g8:
+			return !white && state.testCastleRights(Castle::BK) && !occupancy.test(f8) && !occupancy.test(g8)
+				&& !isSquareAttacked(state, e8, Color::BLACK) && !isSquareAttacked(state, f8, Color::BLACK) && !isSquareAttacked(state, g8, Color::BLACK);
+		case c8:
+			return !white && state.testCastleRights(Castle::BQ) && !occupancy.test(d8) && !occupancy.test(c8) && !occupancy.test(b8)
+				&& !isSquareAttacked(state, e8, Color::BLACK) && !isSquareAttacked(state, d8, Color::BLACK) && !isSquareAttacked(state, c8, Color::BLACK);
+		default:
+			return false;
+		}
+	}
+
+	if (own.test(target))
+	{
+		return false;
+	}
+
+	//double pushes and enpassant store PAWN for both sides and promotions store the new piece
+	const Piece pawn{ white ? Piece::PAWN : Piece::BPAWN };
+	const bool pawn_move{ move.promoted() || move.enpassant() || move.doublePawnPush() || move.piece() == pawn };
+	const Piece piece{ pawn_move ? pawn : move.piece() };
+
+	if (piece / 6 != side || !state.positions()[piece].test(source))
+	{
+		return false;
+	}
+
+	if (pawn_move)
+	{
+		const std::size_t forward{ white ? source - 8 : source + 8 };
+		const bool promotion_rank{ white ? target <= h8 : target >= a1 };
+
+		if (move.promoted() != promotion_rank)
+		{
+			return false;
+		}
+
+		if (move.promoted() && (move.piece() / 6 != side || move.piece() % 6 == Piece::PAWN || move.piece() % 6 == Piece::KING))
+		{
+			return false;
+		}
+
+		if (move.enpassant())
+		{
+			return target == state.enpassantSquare() && m_preGen.pawnAttacks()[side][source].test(target);
+		}
+
+		if (move.capture())
+		{
+			return enemy.test(target) && m_preGen.pawnAttacks()[side][source].test(target);
+		}
+
+		if (move.doublePawnPush())
+		{
+			const bool start_rank{ white ? (source >= a2 && source <= h2) : (source >= a7 && source <= h7) };
+			const std::size_t double_forward{ white ? source - 16 : source + 16 };
+
+			return start_rank && target == double_forward && !occupancy.test(forward) && !occupancy.test(target);
+		}
+
+		return target == forward && !occupancy.test(target);
+	}
+
+	if (move.capture() != enemy.test(target))
+	{
+		return false;
+	}
+
+	switch (piece % 6)
+	{
+	case Piece::KNIGHT:
+		return m_preGen.knightAttacks()[source].test(target);
+	case Piece::BISHOP:
+		return getBishopAttack(source, occupancy).test(target);
+	case Piece::ROOK:
+		return getRookAttack(source, occupancy).test(target);
+	case Piece::QUEEN:
+		return getBishopAttack(source, occupancy).test(target) || getRookAttack(source, occupancy).test(target);
+	case Piece::KING:
+		return m_preGen.kingAttacks()[source].test(target);
+	default:
+		return false;
+	}
+}
+
+bool MoveGen::kingInCheck(const State& state) const
+{
+	return state.whiteToMove() ? kingInCheck<Color::WHITE>(state) : kingInCheck<Color::BLACK>(state);
+}
+
+template<Color C>
+bool MoveGen::kingInCheck(const State& state) const
+{
+	const std::size_t king_square{ state.positions()[C == Color::WHITE ? Piece::KING : Piece::BKING].find_1lsb() };
+
+	if (king_square == SIZE_MAX)
+	{
+		return true;
+	}
+
+	return isSquareAttacked<C>(state, king_square, state.occupancy()[Occupancy::BOTH]);
+}
+
+bool MoveGen::isLegal(State& state, const Move move) const
+{
+	if (!isPseudoLegal(state, move))
+	{
+		return false;
+	}
+
+	//only used for a couple of moves per node so playing it on the board and taking it back is cheaper than the pin and check work
+	UndoInfo undo;
+	state.makeMove(move, undo);
+	const bool legal{ !kingInCheck(state) };
+	state.unmakeMove(move, undo);
+
+	return legal;
+}
+
+//the search and the move picker are compiled once per side and call straight into these
+template void MoveGen::generate<Color::WHITE, GenType::ALL_MOVES>(const State& state, MoveList& moveList) const;
+template void MoveGen::generate<Color::BLACK, GenType::ALL_MOVES>(const State& state, MoveList& moveList) const;
+template void MoveGen::generate<Color::WHITE, GenType::CAPTURE_MOVES>(const State& state, MoveList& moveList) const;
+template void MoveGen::generate<Color::BLACK, GenType::CAPTURE_MOVES>(const State& state, MoveList& moveList) const;
+template void MoveGen::generate<Color::WHITE, GenType::QUIET_MOVES>(const State& state, MoveList& moveList) const;
+template void MoveGen::generate<Color::BLACK, GenType::QUIET_MOVES>(const State& state, MoveList& moveList) const;
+
+template BitBoard MoveGen::attackersTo<Color::WHITE>(const State& state, const std::size_t square, const BitBoard occupancy) const;
+template BitBoard MoveGen::attackersTo<Color::BLACK>(const State& state, const std::size_t square, const BitBoard occupancy) const;
+
+template bool MoveGen::isSquareAttacked<Color::WHITE>(const State& state, const std::size_t square, const BitBoard occupancy) const;
+template bool MoveGen::isSquareAttacked<Color::BLACK>(const State& state, const std::size_t square, const BitBoard occupancy) const;
+
+template bool MoveGen::kingInCheck<Color::WHITE>(const State& state) const;
+template bool MoveGen::kingInCheck<Color::BLACK>(const State& state) const;
+
+template BitBoard MoveGen::getPawnAttack<Color::WHITE>(const std::size_t square) const;
+template BitBoard MoveGen::getPawnAttack<Color::BLACK>(const std::size_t square) const;
\ No newline at end of file
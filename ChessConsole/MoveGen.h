@@ -8,24 +8,85 @@
 #include <cstddef>
 #include "Move.h"
 #include "MoveList.h"
+#include "CpuFeatures.h"
+#include <immintrin.h>
 
 class MoveGen
 {
 private:
-	PreGen m_preGen;
+	//shared by every MoveGen in the process
+	const PreGen& m_preGen;
+	SliderBackend m_sliderBackend;
+
+	//set together with the backend so a lookup is a single indirect call instead of testing the backend every time
+	using SliderLookup = BitBoard(*)(const PreGen& preGen, const SliderMagic& slider, const std::uint64_t occupancy);
+	SliderLookup m_sliderLookup;
 
 public:
 	MoveGen();
 
-	void generateMoves(const State& state, MoveList& moveList);
+	//PEXT can only be selected when the cpu supports it, returns false otherwise
+	bool setSliderBackend(const SliderBackend backend);
+
+	SliderBackend sliderBackend() const;
+
+	void generateMoves(const State& state, MoveList& moveList) const;
+
+	//captures, enpassant and promotions only, used by quiescence search
+	void generateCaptures(const State& state, MoveList& moveList) const;
+
+	//quiet moves and castles, the complement of generateCaptures
+	void generateQuiets(const State& state, MoveList& moveList) const;
+
+	//the side to move is a template argument so every side specific piece, occupancy and pawn direction is a constant
+	template<Color C, GenType G>
+	void generate(const State& state, MoveList& moveList) const;
+
+	//checks a move that did not come from the generator for this state, like a hash or killer move
+	bool isPseudoLegal(const State& state, const Move move) const;
+
+	//pseudo legal and does not leave the king in check, the move is made and taken back on the given state
+	bool isLegal(State& state, const Move move) const;
+
+	//every piece of either color attacking the square, sliders are traced through the given occupancy
+	//one bishop and one rook lookup cover queens too, so check, castling, pin and exchange tests all start from here
+	BitBoard attackersTo(const State& state, const std::size_t square, const BitBoard occupancy) const;
+
+	//only the attackers of side C, the same single pair of slider lookups without loading the other side's pieces
+	template<Color C>
+	BitBoard attackersTo(const State& state, const std::size_t square, const BitBoard occupancy) const;
+
+	//static exchange evaluation, the material the side to move ends up with after both sides keep recapturing on the target
+	//with their least valuable piece, sliders behind a piece that captured join in once it has left
+	int see(const State& state, const Move move) const;
 
 	//color represents defending side
 	bool isSquareAttacked(const State& state, const std::size_t square, const Color side) const;
 
+	//same but sliders are traced through the given occupancy instead of the board
+	bool isSquareAttacked(const State& state, const std::size_t square, const Color side, const BitBoard occupancy) const;
+
+	template<Color C>
+	bool isSquareAttacked(const State& state, const std::size_t square, const BitBoard occupancy) const;
+
+	//enemy pieces attacking the king of side C
+	template<Color C>
+	BitBoard checkers(const State& state, const std::size_t king_square) const;
+
+	//pieces of side C that are the only thing between their king and an enemy slider
+	template<Color C>
+	BitBoard pinnedPieces(const State& state, const std::size_t king_square) const;
+
+	template<Color C>
+	bool isEnpassantLegal(const State& state, const std::size_t source, const std::size_t king_square, const std::uint64_t check_mask) const;
+
 	BitBoard getBishopAttack(const std::size_t square, const BitBoard occupancy) const;
 
 	BitBoard getRookAttack(const std::size_t square, const BitBoard occupancy) const;
 
+	//checks every slider lookup of the current backend against the slow ray tracer
+	bool verifySliderAttacks() const;
+
 	template<Color C>
 	BitBoard getPawnAttack(const std::size_t square) const;
 
@@ -33,5 +94,29 @@ public:
 
 	BitBoard getKingAttack(const std::size_t square) const;
 
-	BitBoard getPieceAttack(const std::size_t P, std::size_t square, const State& state);
+	BitBoard getPieceAttack(const std::size_t P, std::size_t square, const State& state) const;
+
+	bool kingInCheck(const State& state) const;
+
+	template<Color C>
+	bool kingInCheck(const State& state) const;
+
+private:
+	template<Color C, GenType G>
+	void generatePawnMoves(const State& state, MoveList& moveList, const std::size_t king_square, const BitBoard pinned, const std::uint64_t check_mask) const;
+
+	//adds a move for every target, the pawn that makes it stands D squares behind the target
+	template<MoveType M, Piece P, int D>
+	void addPawnMoves(const State& state, MoveList& moveList, const std::uint64_t targets, const std::size_t king_square, const BitBoard pinned) const;
+
+	//knights, bishops, rooks and queens
+	template<Color C, Piece P>
+	void generatePieceMoves(const State& state, MoveList& moveList, const std::uint64_t targets, const std::size_t king_square, const BitBoard pinned, const std::uint64_t check_mask) const;
+
+	template<Color C>
+	void generateCastleMoves(const State& state, MoveList& moveList) const;
+
+	static BitBoard magicSliderAttack(const PreGen& preGen, const SliderMagic& slider, const std::uint64_t occupancy);
+
+	static BitBoard pextSliderAttack(const PreGen& preGen, const SliderMagic& slider, const std::uint64_t occupancy);
 };
\ No newline at end of file
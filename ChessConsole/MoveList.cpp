@@ -2,35 +2,73 @@
 
 
 MoveList::MoveList()
-	: m_moves(), m_count()
+	: m_moves(), m_scores(), m_count() {}
+
+std::span<const Move> MoveList::moves() const
 {
-	m_moves.reserve(256);
+	return { m_moves.data(), m_count };
 }
 
-const std::vector<Move>& MoveList::moves() const
+std::size_t MoveList::count() const
 {
-	return m_moves;
+	return m_count;
 }
 
-std::size_t MoveList::count() const
+int MoveList::score(const std::size_t move_index) const
+{
+	return m_scores[move_index];
+}
+
+void MoveList::setScore(const std::size_t move_index, const int score)
 {
-	return m_moves.size();
+	m_scores[move_index] = score;
+}
+
+void MoveList::clear()
+{
+	m_count = 0;
 }
 
 void MoveList::sortMoveList()
 {
-	std::sort(m_moves.begin(), m_moves.end(), move_compare);
+	//moves and scores have to stay paired so this is a full selection sort
+	for (std::size_t i{}; i < m_count; i++)
+	{
+		pickBest(i);
+	}
+}
+
+void MoveList::pickBest(const std::size_t start)
+{
+	std::size_t best{ start };
+
+	for (std::size_t i{ start + 1 }; i < m_count; i++)
+	{
+		if (m_scores[i] > m_scores[best])
+		{
+			best = i;
+		}
+	}
+
+	std::swap(m_moves[start], m_moves[best]);
+	std::swap(m_scores[start], m_scores[best]);
+}
+
+void MoveList::addMove(const Move move)
+{
+	pushMove(move);
 }
 
 void MoveList::popMove(const std::size_t move_index)
 {
-	std::swap(m_moves[move_index], m_moves.back());
-	m_moves.pop_back();
+	m_count--;
+	m_moves[move_index] = m_moves[m_count];
+	m_scores[move_index] = m_scores[m_count];
 }
 
 bool MoveList::findMove(const std::size_t source, const std::size_t target, Move& move_out) const
 {
-	for (Move move : m_moves)
+	for (const Move move : moves())
 	{
 		if (move.source() == source)
 		{
@@ -47,7 +85,7 @@ bool MoveList::findMove(const std::size_t source, const std::size_t target, Move
 
 bool MoveList::findCastleMove(const std::size_t source) const
 {
-	for (Move move : m_moves)
+	for (const Move move : moves())
 	{
 		if (move.castle())
 		{
@@ -63,7 +101,7 @@ bool MoveList::findCastleMove(const std::size_t source) const
 
 void MoveList::printMoves() const
 {
-	for (std::size_t i{}; i < m_moves.size(); i++)
+	for (std::size_t i{}; i < m_count; i++)
 	{
 		m_moves[i].print();
 	}
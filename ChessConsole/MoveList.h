@@ -3,22 +3,33 @@
 #include "Move.h"
 #include <cstdint>
 #include <cstddef>
-#include <vector>
+#include <array>
+#include <span>
 #include <algorithm>
 
 class MoveList
 {
 private:
-	std::vector<Move> m_moves;
+	//fixed size so a list never touches the heap, the most moves any position can have is 218
+	std::array<Move, MAX_MOVELIST_COUNT> m_moves;
+
+	//ordering score of every move, starts as the mvv lva value and can be changed without touching the move
+	std::array<int, MAX_MOVELIST_COUNT> m_scores;
 
 	std::size_t m_count;
 
 public:
 	MoveList();
 
-	const std::vector<Move>& moves() const;
+	std::span<const Move> moves() const;
 
 	std::size_t count() const;
+
+	int score(const std::size_t move_index) const;
+
+	void setScore(const std::size_t move_index, const int score);
+
+	void clear();
 	
 	void popMove(const std::size_t move_index);
 
@@ -28,6 +39,11 @@ public:
 
 	void sortMoveList();
 
+	//selection sort step, swaps the highest scored move in [start, count) into start
+	void pickBest(const std::size_t start);
+
+	void addMove(const Move move);
+
 	static bool move_compare(const Move a, const Move b);
 
 	void printMoves() const;
@@ -40,42 +56,42 @@ public:
 			if constexpr (P == Piece::PAWN)
 			{
 				//pawn capture
-				m_moves.emplace_back(source, target, Piece::PAWN, captured_piece);
+				pushMove(Move(source, target, Piece::PAWN, captured_piece));
 			}
 			else
 			{
 				//regular capture
-				m_moves.emplace_back(source, target, P, captured_piece);
+				pushMove(Move(source, target, P, captured_piece));
 			}
 		}
 
 		if constexpr (M == MoveType::QUIET)
 		{
 			//regular quiet
-			m_moves.emplace_back(source, target, P, Piece::NO_PIECE);
+			pushMove(Move(source, target, P, Piece::NO_PIECE));
 		}
 
 		if constexpr (M == MoveType::QUIET_PROMOTE)
 		{
 			//quiet promote
-			m_moves.emplace_back(source, target, P, Piece::NO_PIECE, false);
+			pushMove(Move(source, target, P, Piece::NO_PIECE, false));
 		}
 
 		if constexpr (M == MoveType::PROMOTE)
 		{
 			//capture and promote
-			m_moves.emplace_back(source, target, P, captured_piece, true);
+			pushMove(Move(source, target, P, captured_piece, true));
 		}
 
 		if constexpr (M == MoveType::ENPASSANT)
 		{
 			//enpassant
-			m_moves.emplace_back(source, target, captured_piece);
+			pushMove(Move(source, target, captured_piece));
 		}
 
 		if constexpr (M == MoveType::DOUBLE_PAWN)
 		{
-			m_moves.emplace_back(source, target);
+			pushMove(Move(source, target));
 		}
 	}
 
@@ -84,22 +100,30 @@ public:
 	{
 		if constexpr (C == Castle::BK)
 		{
-			m_moves.emplace_back(g8);
+			pushMove(Move(g8));
 		}
 
 		if constexpr (C == Castle::BQ)
 		{
-			m_moves.emplace_back(c8);
+			pushMove(Move(c8));
 		}
 
 		if constexpr (C == Castle::WK)
 		{
-			m_moves.emplace_back(g1);
+			pushMove(Move(g1));
 		}
 
 		if constexpr (C == Castle::WQ)
 		{
-			m_moves.emplace_back(c1);
+			pushMove(Move(c1));
 		}
 	}
-};
+
+private:
+	void pushMove(const Move move)
+	{
+		m_moves[m_count] = move;
+		m_scores[m_count] = static_cast<int>(move.value());
+		m_count++;
+	}
+};
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include "MovePicker.h"
+
+template<Color C>
+MovePicker<C>::MovePicker(const MoveGen& moveGen, State& state, MoveList& moves, MoveList& badCaptures, const Move tt_move, const std::array<Move, MAX_KILLER_MOVES>& killers,
+	const Move counter_move, const HistoryTable& history)
+	: m_moveGen(moveGen), m_state(state), m_moves(moves), m_badCaptures(badCaptures), m_ttMove(tt_move), m_killers(killers), m_counterMove(counter_move), m_history(&history),
+	m_stage(Stage::TT_MOVE), m_index(), m_capturesOnly(false) {}
+
+template<Color C>
+MovePicker<C>::MovePicker(const MoveGen& moveGen, State& state, MoveList& moves, MoveList& badCaptures)
+	: m_moveGen(moveGen), m_state(state), m_moves(moves), m_badCaptures(badCaptures), m_ttMove(), m_killers(), m_counterMove(), m_history(nullptr),
+	m_stage(Stage::GENERATE_CAPTURES), m_index(), m_capturesOnly(true) {}
+
+template<Color C>
+bool MovePicker<C>::next(Move& move_out)
+{
+	switch (m_stage)
+	{
+	case Stage::TT_MOVE:
+		m_stage = Stage::GENERATE_CAPTURES;
+
+		//the hash move can come from a colliding position so it has to be checked before it is played
+		if (m_ttMove.data() && m_moveGen.isLegal(m_state, m_ttMove))
+		{
+			move_out = m_ttMove;
+			return true;
+		}
+		[[fallthrough]];
+
+	case Stage::GENERATE_CAPTURES:
+		m_moves.clear();
+		m_badCaptures.clear();
+		m_moveGen.generate<C, GenType::CAPTURE_MOVES>(m_state, m_moves);
+		m_index = 0;
+		m_stage = Stage::GOOD_CAPTURES;
+		[[fallthrough]];
+
+	case Stage::GOOD_CAPTURES:
+		while (m_index < m_moves.count())
+		{
+			m_moves.pickBest(m_index);
+			const Move move{ m_moves.moves()[m_index++] };
+
+			if (move == m_ttMove)
+			{
+				continue;
+			}
+
+			//losing captures wait until every quiet move has been tried, quiescence does not search them at all
+			if (isLosingCapture(move))
+			{
+				if (!m_capturesOnly)
+				{
+					m_badCaptures.addMove(move);
+				}
+
+				continue;
+			}
+
+			move_out = move;
+			return true;
+		}
+
+		if (m_capturesOnly)
+		{
+			m_stage = Stage::DONE;
+			return false;
+		}
+
+		m_index = 0;
+		m_stage = Stage::KILLERS;
+		[[fallthrough]];
+
+	case Stage::KILLERS:
+		while (m_index < m_killers.size())
+		{
+			const Move killer{ m_killers[m_index++] };
+
+			//captures were already handed out so only quiet killers are tried here
+			if (isQuietRefutation(killer))
+			{
+				move_out = killer;
+				return true;
+			}
+		}
+
+		m_stage = Stage::COUNTER_MOVE;
+		[[fallthrough]];
+
+	case Stage::COUNTER_MOVE:
+		m_stage = Stage::GENERATE_QUIETS;
+
+		//the move that last refuted the opponent's move, unless it already went out as a killer
+		if (isQuietRefutation(m_counterMove) && !isKiller(m_counterMove))
+		{
+			move_out = m_counterMove;
+			return true;
+		}
+		[[fallthrough]];
+
+	case Stage::GENERATE_QUIETS:
+		m_moves.clear();
+		m_moveGen.generate<C, GenType::QUIET_MOVES>(m_state, m_moves);
+
+		for (std::size_t i{}; i < m_moves.count(); i++)
+		{
+			const Move move{ m_moves.moves()[i] };
+			m_moves.setScore(i, (*m_history)[C][move.source()][move.target()]);
+		}
+
+		m_index = 0;
+		m_stage = Stage::QUIETS;
+		[[fallthrough]];
+
+	case Stage::QUIETS:
+		while (m_index < m_moves.count())
+		{
+			m_moves.pickBest(m_index);
+			const Move move{ m_moves.moves()[m_index++] };
+
+			if (move == m_ttMove || move == m_counterMove || isKiller(move))
+			{
+				continue;
+			}
+
+			move_out = move;
+			return true;
+		}
+
+		m_index = 0;
+		m_stage = Stage::BAD_CAPTURES;
+		[[fallthrough]];
+
+	case Stage::BAD_CAPTURES:
+		//already in value order because they were moved here by pickBest
+		if (m_index < m_badCaptures.count())
+		{
+			move_out = m_badCaptures.moves()[m_index++];
+			return true;
+		}
+
+		m_stage = Stage::DONE;
+		[[fallthrough]];
+
+	case Stage::DONE:
+	default:
+		return false;
+	}
+}
+
+template<Color C>
+bool MovePicker<C>::isKiller(const Move move) const
+{
+	for (const Move& killer : m_killers)
+	{
+		if (killer == move)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+template<Color C>
+bool MovePicker<C>::isQuietRefutation(const Move move) const
+{
+	return move.data() && !move.capture() && !move.promoted() && move != m_ttMove && m_moveGen.isLegal(m_state, move);
+}
+
+template<Color C>
+bool MovePicker<C>::isLosingCapture(const Move move) const
+{
+	if (move.promoted() || move.enpassant())
+	{
+		return false;
+	}
+
+	const Piece attacker{ move.piece() };
+	const Piece victim{ m_state.testPieceType(move.target()) };
+
+	//taking something worth at least as much can never lose material, which saves playing out the exchange
+	if (see_value[attacker % 6] <= see_value[victim % 6])
+	{
+		return false;
+	}
+
+	return m_moveGen.see(m_state, move) < 0;
+}
+
+template class MovePicker<Color::WHITE>;
+template class MovePicker<Color::BLACK>;
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "MoveGen.h"
+#include "MoveList.h"
+#include "State.h"
+#include "ChessConstants.hpp"
+#include <array>
+#include <cstddef>
+
+//butterfly history [side][source][target], rises when a quiet move causes a cutoff and falls when another quiet move cuts after it
+using HistoryTable = std::array<std::array<std::array<int, MAX_BOARD_POSITIONS>, MAX_BOARD_POSITIONS>, MAX_COLORS>;
+
+//hands out moves one at a time, each stage is only generated once the one before it runs out
+template<Color C>
+class MovePicker
+{
+private:
+	enum Stage {
+		TT_MOVE,
+		GENERATE_CAPTURES,
+		GOOD_CAPTURES,
+		KILLERS,
+		COUNTER_MOVE,
+		GENERATE_QUIETS,
+		QUIETS,
+		BAD_CAPTURES,
+		DONE
+	};
+
+	const MoveGen& m_moveGen;
+	//the board of the search, isLegal plays a move on it and always takes it back before returning
+	State& m_state;
+
+	//both lists belong to the search stack of the current ply
+	MoveList& m_moves;
+	MoveList& m_badCaptures;
+
+	const Move m_ttMove;
+	const std::array<Move, MAX_KILLER_MOVES> m_killers;
+	const Move m_counterMove;
+
+	//quiet moves are ordered by it, null in quiescence which never gets to them
+	const HistoryTable* m_history;
+
+	Stage m_stage;
+	std::size_t m_index;
+	const bool m_capturesOnly;
+
+public:
+	//main search, TT move, winning captures, killers, the counter move, quiets by history then losing captures
+	MovePicker(const MoveGen& moveGen, State& state, MoveList& moves, MoveList& badCaptures, const Move tt_move, const std::array<Move, MAX_KILLER_MOVES>& killers,
+		const Move counter_move, const HistoryTable& history);
+
+	//quiescence search, captures only
+	MovePicker(const MoveGen& moveGen, State& state, MoveList& moves, MoveList& badCaptures);
+
+	bool next(Move& move_out);
+
+private:
+	bool isKiller(const Move move) const;
+
+	//quiet, not handed out by an earlier stage and legal here
+	bool isQuietRefutation(const Move move) const;
+
+	//negative static exchange, the capturing piece is lost for less than it is worth
+	bool isLosingCapture(const Move move) const;
+};
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "ParallelPerft.h"
+#include <algorithm>
+#include <chrono>
+
+ParallelPerft::ParallelPerft(const MoveGen& moveGen, PerftTable* table)
+	: m_moveGen(moveGen), m_table(table), m_tasks(), m_splitLists(), m_queues() {}
+
+ParallelPerftResult ParallelPerft::run(const State& state, const std::uint32_t depth, const std::size_t thread_count)
+{
+	const auto start{ std::chrono::steady_clock::now() };
+
+	//root and second ply moves give a few hundred to a few thousand subtrees, enough to keep many cores busy
+	m_tasks.clear();
+	State root{ state };
+	split(root, 0, std::min<std::uint32_t>(depth, static_cast<std::uint32_t>(m_splitLists.size())), depth);
+
+	const std::size_t threads{ std::max<std::size_t>(thread_count, 1) };
+
+	m_queues.clear();
+	for (std::size_t i{}; i < threads; i++)
+	{
+		m_queues.push_back(std::make_unique<WorkQueue>());
+	}
+
+	//dealt out round robin so each thread starts with subtrees from many different root moves
+	for (std::size_t i{}; i < m_tasks.size(); i++)
+	{
+		m_queues[i % threads]->m_tasks.push_back(i);
+	}
+
+	std::vector<ParallelPerftResult> thread_results(threads, ParallelPerftResult());
+	std::vector<std::thread> helpers;
+	helpers.reserve(threads - 1);
+
+	for (std::size_t id{ 1 }; id < threads; id++)
+	{
+		helpers.emplace_back([&, id]() { worker(id, thread_results[id]); });
+	}
+
+	worker(0, thread_results[0]);
+
+	for (auto& helper : helpers)
+	{
+		helper.join();
+	}
+
+	ParallelPerftResult result{};
+
+	for (const Task& task : m_tasks)
+	{
+		result.nodes += task.nodes;
+	}
+
+	for (const ParallelPerftResult& thread_result : thread_results)
+	{
+		result.probes += thread_result.probes;
+		result.hits += thread_result.hits;
+		result.steals += thread_result.steals;
+	}
+
+	const std::chrono::duration<double> duration{ std::chrono::steady_clock::now() - start };
+	result.seconds = duration.count();
+
+	return result;
+}
+
+void ParallelPerft::split(State& state, const std::uint32_t ply, const std::uint32_t split_plies, const std::uint32_t depth)
+{
+	if (ply == split_plies)
+	{
+		m_tasks.push_back(Task{ state, depth, 0 });
+		return;
+	}
+
+	MoveList& list{ m_splitLists[ply] };
+	list.clear();
+	m_moveGen.generateMoves(state, list);
+
+	UndoInfo undo;
+
+	for (const Move& move : list.moves())
+	{
+		state.makeMove(move, undo);
+		state.flipSide();
+		split(state, ply + 1, split_plies, depth - 1);
+		state.flipSide();
+		state.unmakeMove(move, undo);
+	}
+}
+
+void ParallelPerft::worker(const std::size_t id, ParallelPerftResult& result)
+{
+	Perft perft{ m_moveGen, m_table };
+	std::size_t task_index{};
+	bool stolen{ false };
+
+	while (popTask(id, task_index, stolen))
+	{
+		Task& task{ m_tasks[task_index] };
+		task.nodes = perft.count(task.state, task.depth);
+
+		if (stolen)
+		{
+			result.steals++;
+		}
+	}
+
+	result.probes = perft.probes();
+	result.hits = perft.hits();
+}
+
+bool ParallelPerft::popTask(const std::size_t id, std::size_t& task_out, bool& stolen)
+{
+	{
+		WorkQueue& own{ *m_queues[id] };
+		std::lock_guard<std::mutex> lock{ own.m_mutex };
+
+		if (!own.m_tasks.empty())
+		{
+			task_out = own.m_tasks.back();
+			own.m_tasks.pop_back();
+			stolen = false;
+			return true;
+		}
+	}
+
+	//every task exists before the threads start, so once all queues are empty the count is done
+	for (std::size_t offset{ 1 }; offset < m_queues.size(); offset++)
+	{
+		WorkQueue& victim{ *m_queues[(id + offset) % m_queues.size()] };
+		std::lock_guard<std::mutex> lock{ victim.m_mutex };
+
+		if (!victim.m_tasks.empty())
+		{
+			task_out = victim.m_tasks.front();
+			victim.m_tasks.pop_front();
+			stolen = true;
+			return true;
+		}
+	}
+
+	return false;
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "MoveGen.h"
+#include "MoveList.h"
+#include "State.h"
+#include "Perft.h"
+#include "PerftTable.h"
+#include "ChessConstants.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <thread>
+
+struct ParallelPerftResult
+{
+	std::uint64_t nodes;
+	std::uint64_t probes;
+	std::uint64_t hits;
+	std::uint64_t steals;
+	double seconds;
+};
+
+//splits the first two plies into subtrees and counts them on a work stealing thread pool
+class ParallelPerft
+{
+private:
+	//one subtree below the split, counted by whichever thread takes it
+	struct Task
+	{
+		State state;
+		std::uint32_t depth;
+		std::uint64_t nodes;
+	};
+
+	//each thread works from the back of its own queue and steals from the front of the others
+	struct alignas(64) WorkQueue
+	{
+		std::mutex m_mutex;
+		std::deque<std::size_t> m_tasks;
+	};
+
+	const MoveGen& m_moveGen;
+
+	//optional, shared by every thread so a transposition found by one is reused by all
+	PerftTable* m_table;
+
+	std::vector<Task> m_tasks;
+
+	//move lists for the plies above the split
+	std::array<MoveList, 2> m_splitLists;
+	std::vector<std::unique_ptr<WorkQueue>> m_queues;
+
+public:
+	ParallelPerft(const MoveGen& moveGen, PerftTable* table);
+
+	ParallelPerftResult run(const State& state, const std::uint32_t depth, const std::size_t thread_count);
+
+private:
+	void split(State& state, const std::uint32_t ply, const std::uint32_t split_plies, const std::uint32_t depth);
+
+	void worker(const std::size_t id, ParallelPerftResult& result);
+
+	bool popTask(const std::size_t id, std::size_t& task_out, bool& stolen);
+};
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "Perft.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+Perft::Perft(const MoveGen& moveGen, PerftTable* table)
+	: m_moveGen(moveGen), m_lists(MAX_SEARCH_PLY), m_table(table), m_probes(), m_hits() {}
+
+std::uint64_t Perft::count(State& state, const std::uint32_t depth)
+{
+	if (depth == 0)
+	{
+		return 1;
+	}
+
+	//depth 1 is a single generation, cheaper than a table lookup
+	if (m_table && depth > 1)
+	{
+		std::uint64_t cached_nodes{};
+		m_probes++;
+
+		if (m_table->probe(state.hash(), depth, cached_nodes))
+		{
+			m_hits++;
+			return cached_nodes;
+		}
+	}
+
+	MoveList& list{ listFor(depth) };
+	list.clear();
+	m_moveGen.generateMoves(state, list);
+
+	//bulk counting, every generated move is legal so there is no need to play the last ply
+	if (depth == 1)
+	{
+		return list.count();
+	}
+
+	std::uint64_t nodes{};
+	UndoInfo undo;
+
+	for (const Move& move : list.moves())
+	{
+		state.makeMove(move, undo);
+		state.flipSide();
+		nodes += count(state, depth - 1);
+		state.flipSide();
+		state.unmakeMove(move, undo);
+	}
+
+	if (m_table)
+	{
+		m_table->store(state.hash(), depth, nodes);
+	}
+
+	return nodes;
+}
+
+std::uint64_t Perft::divide(State& state, const std::uint32_t depth)
+{
+	if (depth == 0)
+	{
+		return 1;
+	}
+
+	const auto start{ std::chrono::steady_clock::now() };
+
+	//the root list is copied because count reuses the per depth lists
+	MoveList root;
+	m_moveGen.generateMoves(state, root);
+
+	std::uint64_t nodes{};
+	UndoInfo undo;
+
+	for (const Move& move : root.moves())
+	{
+		state.makeMove(move, undo);
+		state.flipSide();
+		const std::uint64_t move_nodes{ count(state, depth - 1) };
+		state.flipSide();
+		state.unmakeMove(move, undo);
+
+		std::cout << move.toString() << ": " << move_nodes << std::endl;
+		nodes += move_nodes;
+	}
+
+	const std::chrono::duration<double> duration{ std::chrono::steady_clock::now() - start };
+
+	std::cout << std::endl << "moves: " << root.count() << std::endl;
+	std::cout << "nodes: " << nodes << std::endl;
+	std::cout << "time: " << std::fixed << std::setprecision(3) << duration.count() << "s" << std::endl;
+	std::cout << "nps: " << static_cast<std::uint64_t>(nodes / std::max(duration.count(), 0.001)) << std::endl;
+
+	return nodes;
+}
+
+bool Perft::runSuite()
+{
+	bool passed{ true };
+	std::uint64_t total_nodes{};
+
+	const auto suite_start{ std::chrono::steady_clock::now() };
+
+	std::cout << "position  depth           nodes        expected     time" << std::endl;
+
+	for (std::size_t i{}; i < perft_suite.size(); i++)
+	{
+		const PerftPosition& position{ perft_suite[i] };
+		State state{ State::parse_fen(position.fen) };
+
+		const auto start{ std::chrono::steady_clock::now() };
+		const std::uint64_t nodes{ count(state, position.depth) };
+		const std::chrono::duration<double> duration{ std::chrono::steady_clock::now() - start };
+
+		std::cout << std::setw(8) << i
+			<< std::setw(7) << position.depth
+			<< std::setw(16) << nodes
+			<< std::setw(16) << position.nodes
+			<< std::setw(9) << std::fixed << std::setprecision(3) << duration.count();
+
+		if (nodes != position.nodes)
+		{
+			std::cout << "   FAILED";
+			passed = false;
+		}
+
+		std::cout << std::endl;
+		total_nodes += nodes;
+	}
+
+	const std::chrono::duration<double> duration{ std::chrono::steady_clock::now() - suite_start };
+
+	std::cout << (passed ? "all positions passed, " : "perft suite failed, ") << total_nodes << " nodes at "
+		<< static_cast<std::uint64_t>(total_nodes / std::max(duration.count(), 0.001)) << " nps" << std::endl;
+
+	return passed;
+}
+
+std::uint64_t Perft::probes() const
+{
+	return m_probes;
+}
+
+std::uint64_t Perft::hits() const
+{
+	return m_hits;
+}
+
+MoveList& Perft::listFor(const std::uint32_t depth)
+{
+	//divide can be asked for any depth, the lists only grow when that happens
+	if (depth >= m_lists.size())
+	{
+		m_lists.resize(depth + 1);
+	}
+
+	return m_lists[depth];
+}
\ No newline at end of file
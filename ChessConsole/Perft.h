@@ -0,0 +1,43 @@
+#pragma once
+
+#include "MoveGen.h"
+#include "MoveList.h"
+#include "State.h"
+#include "PerftTable.h"
+#include "ChessConstants.hpp"
+#include <cstdint>
+#include <vector>
+
+//counts the leaves of the legal move tree, any difference from the known numbers is a move generation bug
+class Perft
+{
+private:
+	const MoveGen& m_moveGen;
+
+	//one list per remaining depth, kept on the heap because the suite goes deeper than the search stack
+	std::vector<MoveList> m_lists;
+
+	//optional, shared between every thread of a parallel perft
+	PerftTable* m_table;
+	std::uint64_t m_probes;
+	std::uint64_t m_hits;
+
+public:
+	Perft(const MoveGen& moveGen, PerftTable* table = nullptr);
+
+	//the last ply is not played, the legal move count of each parent is the number of leaves below it
+	std::uint64_t count(State& state, const std::uint32_t depth);
+
+	//prints the leaf count below every root move, used to find which line a wrong total comes from
+	std::uint64_t divide(State& state, const std::uint32_t depth);
+
+	//runs every position in perft_suite and returns false if any count is wrong
+	bool runSuite();
+
+	std::uint64_t probes() const;
+
+	std::uint64_t hits() const;
+
+private:
+	MoveList& listFor(const std::uint32_t depth);
+};
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "PerftTable.h"
+#include "TableSize.h"
+
+PerftTable::PerftTable(const std::size_t megabytes)
+	: m_buckets(), m_bucketMask()
+{
+	const std::size_t bucket_count{ table_bucket_count(megabytes, sizeof(Bucket)) };
+
+	m_buckets = std::vector<Bucket>(bucket_count);
+	m_bucketMask = bucket_count - 1;
+}
+
+void PerftTable::clear()
+{
+	for (Bucket& bucket : m_buckets)
+	{
+		for (Slot& slot : bucket.m_slots)
+		{
+			slot.m_key.store(0, std::memory_order_relaxed);
+			slot.m_data.store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+bool PerftTable::probe(const std::uint64_t key, const std::uint32_t depth, std::uint64_t& nodes_out) const
+{
+	const Bucket& bucket{ m_buckets[key & m_bucketMask] };
+
+	for (const Slot& slot : bucket.m_slots)
+	{
+		const std::uint64_t data{ slot.m_data.load(std::memory_order_relaxed) };
+		const std::uint64_t slot_key{ slot.m_key.load(std::memory_order_relaxed) ^ data };
+
+		//the same position counted to a different depth is a different entry
+		if (slot_key == key && data && (data & perft_depth_mask) == depth)
+		{
+			nodes_out = data >> perft_nodes_shift;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void PerftTable::store(const std::uint64_t key, const std::uint32_t depth, const std::uint64_t nodes)
+{
+	Bucket& bucket{ m_buckets[key & m_bucketMask] };
+	Slot* replace{ &bucket.m_slots[0] };
+	std::uint64_t replace_depth{ UINT64_MAX };
+
+	for (Slot& slot : bucket.m_slots)
+	{
+		const std::uint64_t slot_depth{ slot.m_data.load(std::memory_order_relaxed) & perft_depth_mask };
+
+		if (slot_depth < replace_depth)
+		{
+			replace_depth = slot_depth;
+			replace = &slot;
+		}
+	}
+
+	const std::uint64_t data{ (nodes << perft_nodes_shift) | (depth & perft_depth_mask) };
+
+	replace->m_data.store(data, std::memory_order_relaxed);
+	replace->m_key.store(key ^ data, std::memory_order_relaxed);
+}
+
+std::size_t PerftTable::sizeMB() const
+{
+	return (m_buckets.size() * sizeof(Bucket)) / (1024 * 1024);
+}
\ No newline at end of file
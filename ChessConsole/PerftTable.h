@@ -0,0 +1,44 @@
+#pragma once
+
+#include "ChessConstants.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+
+constexpr std::size_t perft_nodes_shift{ 8 };
+constexpr std::uint64_t perft_depth_mask{ 0x00000000000000FF };
+
+//subtree counts keyed by hash and depth, so a position reached through different move orders is only counted once
+class PerftTable
+{
+private:
+	//same layout as the transposition table, m_key holds key ^ data so a torn slot fails the key check
+	struct Slot
+	{
+		std::atomic<std::uint64_t> m_key;
+		std::atomic<std::uint64_t> m_data;
+	};
+
+	struct alignas(64) Bucket
+	{
+		std::array<Slot, TRANSPOSITION_BUCKET_SIZE> m_slots;
+	};
+
+	std::vector<Bucket> m_buckets;
+	std::size_t m_bucketMask;
+
+public:
+	PerftTable(const std::size_t megabytes);
+
+	void clear();
+
+	bool probe(const std::uint64_t key, const std::uint32_t depth, std::uint64_t& nodes_out) const;
+
+	//replaces the shallowest slot of the bucket, deep subtrees are the expensive ones to count again
+	void store(const std::uint64_t key, const std::uint32_t depth, const std::uint64_t nodes);
+
+	std::size_t sizeMB() const;
+};
\ No newline at end of file
@@ -1,514 +1,484 @@
 #include "PreGen.h"
 
+#include <bit>
 
 
-PreGen::PreGen()
-	: m_pawnAttackMasks(), m_knightAttackMasks(), m_kingAttackMasks(), m_bishopAttackMask(), m_rookAttackMask(),
 
-	m_bishopRelevantBits(), m_rookRelevantBits(), 
-
-	m_bishopMagics(), m_rookMagics(),
-
-	m_northEdgeMask(), m_eastEdgeMask(), m_southEdgeMask(), m_westEdgeMask(),
-
-	m_bishopBitCount(), m_rookBitCount()
+namespace
 {
-	//slider masks 
-	createBishopAttackMasks();
-	createRookAttackMasks();
-
-	//magics
-	createBishopBitCount();
-	createRookBitCount();
-	InitMagicNumbers();
-
-	std::cout << "Generating Tables" << std::endl;
-	//bishop and rook attacks
-	createBishopAttacks();
-	createRookAttacks();
-
-	//non slider attacks
-	createPawnAttackMasks();
-	createKnightAttackMasks();
-	createKingAttackMasks();
-	createEdgeMasks();
-
-	std::cout << "Tables Generated" << std::endl;
-}
-
-// Getters
-const std::array<std::array<BitBoard, MAX_BOARD_POSITIONS>, 2>& PreGen::pawnAttacks() const
-{
-	return m_pawnAttackMasks;
-}
-
-const std::array<BitBoard, MAX_BOARD_POSITIONS>& PreGen::knightAttacks() const
-{
-	return m_knightAttackMasks;
-}
+	// Non Slider Piece Creation
+	constexpr std::array<std::array<BitBoard, MAX_BOARD_POSITIONS>, 2> create_pawn_attack_masks()
+	{
+		std::array<std::array<BitBoard, MAX_BOARD_POSITIONS>, 2> masks{};
 
-const std::array<BitBoard, MAX_BOARD_POSITIONS>& PreGen::kingAttacks() const
-{
-	return m_kingAttackMasks;
-}
+		for (std::size_t r{}; r < RANK_MAX; r++)
+		{
+			for (std::size_t f{}; f < FILE_MAX; f++)
+			{
+				//white
+				masks[Color::WHITE][PreGen::indexAttackTable(r, f)].set_rf_safe(r - 1, f + 1);
+				masks[Color::WHITE][PreGen::indexAttackTable(r, f)].set_rf_safe(r - 1, f - 1);
 
-const std::array<std::array<BitBoard, MAX_BISHOP_ATTACKS>, MAX_BOARD_POSITIONS>& PreGen::bishopAttacks() const
-{
-	return m_bishopAttackMask;
-}
+				//black
+				masks[Color::BLACK][PreGen::indexAttackTable(r, f)].set_rf_safe(r + 1, f + 1);
+				masks[Color::BLACK][PreGen::indexAttackTable(r, f)].set_rf_safe(r + 1, f - 1);
+			}
+		}
 
-const std::array<std::array<BitBoard, MAX_ROOK_ATTACKS>, MAX_BOARD_POSITIONS>& PreGen::rookAttacks() const
-{
-	return m_rookAttackMask;
-}
+		return masks;
+	}
 
-const std::array<std::uint64_t, MAX_BOARD_POSITIONS>& PreGen::bishopMagics() const
-{
-	return m_bishopMagics;
-}
+	constexpr std::array<BitBoard, MAX_BOARD_POSITIONS> create_knight_attack_masks()
+	{
+		std::array<BitBoard, MAX_BOARD_POSITIONS> masks{};
 
-const std::array<std::uint64_t, MAX_BOARD_POSITIONS>& PreGen::rookMagics() const
-{
-	return m_rookMagics;
-}
+		for (std::size_t r{}; r < RANK_MAX; r++)
+		{
+			for (std::size_t f{}; f < FILE_MAX; f++)
+			{
+				//NORTH
+				masks[PreGen::indexAttackTable(r, f)].set_rf_safe(r + 2, f + 1);
+				masks[PreGen::indexAttackTable(r, f)].set_rf_safe(r + 2, f - 1);
 
-const std::array<std::size_t, MAX_BOARD_POSITIONS>& PreGen::bishopBitCount() const
-{
-	return m_bishopBitCount;
-}
+				//EAST
+				masks[PreGen::indexAttackTable(r, f)].set_rf_safe(r + 1, f + 2);
+				masks[PreGen::indexAttackTable(r, f)].set_rf_safe(r - 1, f + 2);
 
-const std::array<std::size_t, MAX_BOARD_POSITIONS>& PreGen::rookBitCount() const
-{
-	return m_rookBitCount;
-}
+				//SOUTH
+				masks[PreGen::indexAttackTable(r, f)].set_rf_safe(r - 2, f + 1);
+				masks[PreGen::indexAttackTable(r, f)].set_rf_safe(r - 2, f - 1);
 
+				//WEST
+				masks[PreGen::indexAttackTable(r, f)].set_rf_safe(r + 1, f - 2);
+				masks[PreGen::indexAttackTable(r, f)].set_rf_safe(r - 1, f - 2);
+			}
+		}
 
+		return masks;
+	}
 
-// Non Slider Piece Creation
-void PreGen::createPawnAttackMasks()
-{
-	//white
-	for (std::size_t r{}; r < RANK_MAX; r++)
+	constexpr std::array<BitBoard, MAX_BOARD_POSITIONS> create_king_attack_masks()
 	{
-		for (std::size_t f{}; f < FILE_MAX; f++)
+		std::array<BitBoard, MAX_BOARD_POSITIONS> masks{};
+
+		for (std::size_t r{}; r < RANK_MAX; r++)
 		{
-			m_pawnAttackMasks[Color::WHITE][indexAttackTable(r, f)].set_rf_safe(r - 1, f + 1);
-			m_pawnAttackMasks[Color::WHITE][indexAttackTable(r, f)].set_rf_safe(r - 1, f - 1);
+			for (std::size_t f{}; f < FILE_MAX; f++)
+			{
+				masks[PreGen::indexAttackTable(r, f)].set_rf_safe(r + 1, f); //N
+				masks[PreGen::indexAttackTable(r, f)].set_rf_safe(r + 1, f + 1); //NE
+				masks[PreGen::indexAttackTable(r, f)].set_rf_safe(r, f + 1); //E
+				masks[PreGen::indexAttackTable(r, f)].set_rf_safe(r - 1, f + 1); //SE
+				masks[PreGen::indexAttackTable(r, f)].set_rf_safe(r - 1, f); //S
+				masks[PreGen::indexAttackTable(r, f)].set_rf_safe(r - 1, f - 1); //SW
+				masks[PreGen::indexAttackTable(r, f)].set_rf_safe(r, f - 1); //W
+				masks[PreGen::indexAttackTable(r, f)].set_rf_safe(r + 1, f - 1); //NW
+			}
 		}
+
+		return masks;
 	}
 
-	//black
-	for (std::size_t r{}; r < RANK_MAX; r++)
+
+
+	// Slider Piece Creation
+	constexpr std::array<BitBoard, MAX_BOARD_POSITIONS> create_bishop_attack_masks()
 	{
-		for (std::size_t f{}; f < FILE_MAX; f++)
+		std::array<BitBoard, MAX_BOARD_POSITIONS> masks{};
+
+		for (std::int64_t tr{}; tr < static_cast<std::int64_t>(RANK_MAX); tr++)
 		{
-			m_pawnAttackMasks[Color::BLACK][indexAttackTable(r, f)].set_rf_safe(r + 1, f + 1);
-			m_pawnAttackMasks[Color::BLACK][indexAttackTable(r, f)].set_rf_safe(r + 1, f - 1);
+			for (std::int64_t tf{}; tf < static_cast<std::int64_t>(FILE_MAX); tf++)
+			{
+				std::int64_t r{};
+				std::int64_t f{};
+
+				for (r = tr + 1, f = tf + 1; r <= 6 && f <= 6; r++, f++) masks[PreGen::indexAttackTable(tr, tf)].set_rf(r, f);
+				for (r = tr + 1, f = tf - 1; r <= 6 && f >= 1; r++, f--) masks[PreGen::indexAttackTable(tr, tf)].set_rf(r, f);
+				for (r = tr - 1, f = tf - 1; r >= 1 && f >= 1; r--, f--) masks[PreGen::indexAttackTable(tr, tf)].set_rf(r, f);
+				for (r = tr - 1, f = tf + 1; r >= 1 && f <= 6; r--, f++) masks[PreGen::indexAttackTable(tr, tf)].set_rf(r, f);
+			}
 		}
+
+		return masks;
 	}
-}
 
-void PreGen::createKnightAttackMasks()
-{
-	for (std::size_t r{}; r < RANK_MAX; r++)
+	constexpr std::array<BitBoard, MAX_BOARD_POSITIONS> create_rook_attack_masks()
 	{
-		for (std::size_t f{}; f < FILE_MAX; f++)
-		{
-			//NORTH
-			m_knightAttackMasks[indexAttackTable(r, f)].set_rf_safe(r + 2, f + 1);
-			m_knightAttackMasks[indexAttackTable(r, f)].set_rf_safe(r + 2, f - 1);
-
-			//EAST		  
-			m_knightAttackMasks[indexAttackTable(r, f)].set_rf_safe(r + 1, f + 2);
-			m_knightAttackMasks[indexAttackTable(r, f)].set_rf_safe(r - 1, f + 2);
+		std::array<BitBoard, MAX_BOARD_POSITIONS> masks{};
 
-			//SOUTH		  
-			m_knightAttackMasks[indexAttackTable(r, f)].set_rf_safe(r - 2, f + 1);
-			m_knightAttackMasks[indexAttackTable(r, f)].set_rf_safe(r - 2, f - 1);
+		for (std::int64_t tr{}; tr < static_cast<std::int64_t>(RANK_MAX); tr++)
+		{
+			for (std::int64_t tf{}; tf < static_cast<std::int64_t>(FILE_MAX); tf++)
+			{
+				std::int64_t r{};
+				std::int64_t f{};
 
-			//WEST		  
-			m_knightAttackMasks[indexAttackTable(r, f)].set_rf_safe(r + 1, f - 2);
-			m_knightAttackMasks[indexAttackTable(r, f)].set_rf_safe(r - 1, f - 2);
+				for (r = tr + 1; r <= 6; r++) masks[PreGen::indexAttackTable(tr, tf)].set_rf(r, tf);
+				for (r = tr - 1; r >= 1; r--) masks[PreGen::indexAttackTable(tr, tf)].set_rf(r, tf);
+				for (f = tf + 1; f <= 6; f++) masks[PreGen::indexAttackTable(tr, tf)].set_rf(tr, f);
+				for (f = tf - 1; f >= 1; f--) masks[PreGen::indexAttackTable(tr, tf)].set_rf(tr, f);
+			}
 		}
+
+		return masks;
 	}
-}
 
-void PreGen::createKingAttackMasks()
-{
-	for (std::size_t r{}; r < RANK_MAX; r++)
+	constexpr std::array<std::size_t, MAX_BOARD_POSITIONS> create_bit_count(const std::array<BitBoard, MAX_BOARD_POSITIONS>& masks)
 	{
-		for (std::size_t f{}; f < FILE_MAX; f++)
+		std::array<std::size_t, MAX_BOARD_POSITIONS> bit_count{};
+
+		for (std::size_t i{}; i < MAX_BOARD_POSITIONS; i++)
 		{
-			m_kingAttackMasks[indexAttackTable(r, f)].set_rf_safe(r + 1, f); //N
-			m_kingAttackMasks[indexAttackTable(r, f)].set_rf_safe(r + 1, f + 1); //NE
-			m_kingAttackMasks[indexAttackTable(r, f)].set_rf_safe(r, f + 1); //E
-			m_kingAttackMasks[indexAttackTable(r, f)].set_rf_safe(r - 1, f + 1); //SE
-			m_kingAttackMasks[indexAttackTable(r, f)].set_rf_safe(r - 1, f); //S
-			m_kingAttackMasks[indexAttackTable(r, f)].set_rf_safe(r - 1, f - 1); //SW
-			m_kingAttackMasks[indexAttackTable(r, f)].set_rf_safe(r, f - 1); //W
-			m_kingAttackMasks[indexAttackTable(r, f)].set_rf_safe(r + 1, f - 1); //NW
+			bit_count[i] = static_cast<std::size_t>(std::popcount(masks[i].board()));
 		}
+
+		return bit_count;
 	}
-}
 
-void PreGen::createEdgeMasks()
-{
-	for (size_t r{}; r < RANK_MAX; r++)
+	template<Piece P>
+	constexpr BitBoard create_slider_attack(const std::size_t square, const BitBoard occupancy)
 	{
-		for (size_t f{}; f < FILE_MAX; f++)
+		BitBoard mask;
+
+		int tr{ static_cast<int>(square / 8) };
+		int tf{ static_cast<int>(square % 8) };
+
+		int r{};
+		int f{};
+
+		if constexpr (P == Piece::BISHOP)
 		{
-			//north
-			if (r == 0)
+			for (r = tr + 1, f = tf + 1; r <= 7 && f <= 7; r++, f++)
 			{
-				m_northEdgeMask.set_rf_safe(r, f);
+				mask.set_rf(r, f);
+
+				if (occupancy.test_rf(r, f))
+				{
+					break;
+				}
 			}
 
-			//east
-			if (f == 7)
+			for (r = tr + 1, f = tf - 1; r <= 7 && f >= 0; r++, f--)
 			{
-				m_eastEdgeMask.set_rf_safe(r, f);
+				mask.set_rf(r, f);
+
+				if (occupancy.test_rf(r, f))
+				{
+					break;
+				}
 			}
 
-			//south
-			if (r == 7)
+			for (r = tr - 1, f = tf - 1; r >= 0 && f >= 0; r--, f--)
 			{
-				m_southEdgeMask.set_rf_safe(r, f);
-			}
+				mask.set_rf(r, f);
 
-			//west
-			if (f == 0)
+				if (occupancy.test_rf(r, f))
+				{
+					break;
+				}
+			}
+			for (r = tr - 1, f = tf + 1; r >= 0 && f <= 7; r--, f++)
 			{
-				m_westEdgeMask.set_rf_safe(r, f);
+				mask.set_rf(r, f);
+
+				if (occupancy.test_rf(r, f))
+				{
+					break;
+				}
 			}
 		}
-	}
-}
+		else
+		{
+			for (r = tr + 1; r <= 7; r++)
+			{
+				mask.set_rf(r, tf);
 
+				if (occupancy.test_rf(r, tf))
+				{
+					break;
+				}
+			}
 
+			for (r = tr - 1; r >= 0; r--)
+			{
+				mask.set_rf(r, tf);
 
-// Slider Piece Creation
-void PreGen::createBishopAttackMasks()
-{
-	for (std::size_t tr{}; tr < RANK_MAX; tr++)
-	{
-		for (std::size_t tf{}; tf < FILE_MAX; tf++)
-		{
-			std::int64_t r{};
-			std::int64_t f{};
+				if (occupancy.test_rf(r, tf))
+				{
+					break;
+				}
+			}
 
-			for (r = tr + 1, f = tf + 1; r <= 6 && f <= 6; r++, f++) m_bishopRelevantBits[indexAttackTable(tr, tf)].set_rf(r, f);
-			for (r = tr + 1, f = tf - 1; r <= 6 && f >= 1; r++, f--) m_bishopRelevantBits[indexAttackTable(tr, tf)].set_rf(r, f);
-			for (r = tr - 1, f = tf - 1; r >= 1 && f >= 1; r--, f--) m_bishopRelevantBits[indexAttackTable(tr, tf)].set_rf(r, f);
-			for (r = tr - 1, f = tf + 1; r >= 1 && f <= 6; r--, f++) m_bishopRelevantBits[indexAttackTable(tr, tf)].set_rf(r, f);
-		}
-	}
-}
+			for (f = tf + 1; f <= 7; f++)
+			{
+				mask.set_rf(tr, f);
 
-void PreGen::createRookAttackMasks()
-{
-	for (std::size_t tr{}; tr < RANK_MAX; tr++)
-	{
-		for (std::size_t tf{}; tf < FILE_MAX; tf++)
-		{
-			std::int64_t r{};
-			std::int64_t f{};
+				if (occupancy.test_rf(tr, f))
+				{
+					break;
+				}
+			}
 
-			for (r = tr + 1; r <= 6; r++) m_rookRelevantBits[indexAttackTable(tr, tf)].set_rf(r, tf);
-			for (r = tr - 1; r >= 1; r--) m_rookRelevantBits[indexAttackTable(tr, tf)].set_rf(r, tf);
-			for (f = tf + 1; f <= 6; f++) m_rookRelevantBits[indexAttackTable(tr, tf)].set_rf(tr, f);
-			for (f = tf - 1; f >= 1; f--) m_rookRelevantBits[indexAttackTable(tr, tf)].set_rf(tr, f);
+			for (f = tf - 1; f >= 0; f--)
+			{
+				mask.set_rf(tr, f);
+
+				if (occupancy.test_rf(tr, f))
+				{
+					break;
+				}
+			}
 		}
-	}
-}
 
-void PreGen::createBishopBitCount()
-{
-	for (std::size_t i{}; i < MAX_BOARD_POSITIONS; i++)
-	{
-		m_bishopBitCount[i] = (__popcnt64(m_bishopRelevantBits[i].board()));
+		return mask;
 	}
-}
 
-void PreGen::createRookBitCount()
-{
-	for (std::size_t i{}; i < MAX_BOARD_POSITIONS; i++)
-	{
-		m_rookBitCount[i] = (__popcnt64(m_rookRelevantBits[i].board()));
-	}
-}
+	alignas(64) constexpr std::array<BitBoard, MAX_BOARD_POSITIONS> bishop_relevant_bits{ create_bishop_attack_masks() };
+	alignas(64) constexpr std::array<BitBoard, MAX_BOARD_POSITIONS> rook_relevant_bits{ create_rook_attack_masks() };
+	alignas(64) constexpr std::array<std::size_t, MAX_BOARD_POSITIONS> bishop_bit_count{ create_bit_count(bishop_relevant_bits) };
+	alignas(64) constexpr std::array<std::size_t, MAX_BOARD_POSITIONS> rook_bit_count{ create_bit_count(rook_relevant_bits) };
 
-void PreGen::createBishopAttacks()
-{
-	for (std::size_t i{}; i < MAX_BOARD_POSITIONS; i++)
+	struct alignas(64) SliderTables
 	{
-		const std::size_t magic_number{ m_bishopMagics[i] };
-
-		const std::vector<BitBoard> occupancies{ createOccupancies(m_bishopRelevantBits[i].board(), m_bishopBitCount[i], single_bit << m_bishopBitCount[i]) };
+		std::array<SliderMagic, MAX_BOARD_POSITIONS> bishop;
+		std::array<SliderMagic, MAX_BOARD_POSITIONS> rook;
+		std::array<BitBoard, pregen::slider_table_size> magic;
+		std::array<BitBoard, PEXT_ATTACK_TABLE_SIZE> pext;
+	};
+
+	template<Piece P>
+	constexpr void create_slider_attacks(SliderTables& tables, std::size_t& offset, std::size_t& pext_offset)
+	{
+		std::array<SliderMagic, MAX_BOARD_POSITIONS>& sliders{ P == Piece::BISHOP ? tables.bishop : tables.rook };
 
-		for (std::size_t j{}; j < occupancies.size(); j++)
+		for (std::size_t i{}; i < MAX_BOARD_POSITIONS; i++)
 		{
-			const BitBoard attack{ createSliderAttack<Piece::BISHOP>(i, occupancies[j]) };
+			const std::size_t bit_count{ P == Piece::BISHOP ? bishop_bit_count[i] : rook_bit_count[i] };
+			const std::uint64_t mask{ P == Piece::BISHOP ? bishop_relevant_bits[i].board() : rook_relevant_bits[i].board() };
+			const std::uint64_t magic_number{ P == Piece::BISHOP ? pregen::bishop_magics[i] : pregen::rook_magics[i] };
+			const std::uint32_t shift{ P == Piece::BISHOP ? pregen::bishop_shifts[i] : pregen::rook_shifts[i] };
 
-			const std::size_t magic_index{ (occupancies[j].board() * magic_number) >> (MAX_BOARD_POSITIONS - m_bishopBitCount[i]) };
+			sliders[i] = SliderMagic{ mask, magic_number, static_cast<std::uint32_t>(offset), shift, static_cast<std::uint32_t>(pext_offset) };
 
-			m_bishopAttackMask[i][magic_index] = attack;
-		}
-	}
-}
+			//walks every subset of the mask in the order of the bits of j spread over it, which PEXT packs straight back into j
+			std::uint64_t occupancy{};
 
-void PreGen::createRookAttacks()
-{
-	for (std::size_t i{}; i < MAX_BOARD_POSITIONS; i++)
-	{
-		const std::size_t magic_number{ m_rookMagics[i] };
+			for (std::uint64_t j{}; j < (single_bit << bit_count); j++, occupancy = (occupancy - mask) & mask)
+			{
+				const BitBoard attack{ create_slider_attack<P>(i, occupancy) };
 
-		const std::vector<BitBoard> occupancies{ createOccupancies(m_rookRelevantBits[i].board(), m_rookBitCount[i], single_bit << m_rookBitCount[i]) };
+				const std::size_t magic_index{ static_cast<std::size_t>((occupancy * magic_number) >> shift) };
 
-		for (std::size_t j{}; j < occupancies.size(); j++)
-		{
-			const BitBoard attack{ createSliderAttack<Piece::ROOK>(i, occupancies[j]) };
+				//a slider always attacks at least one square so an empty entry has not been written yet,
+				//and throwing is not a constant expression so a magic that sends two different attacks to one entry stops the build
+				if (tables.magic[offset + magic_index].board() && tables.magic[offset + magic_index].board() != attack.board())
+				{
+					throw "magic collision";
+				}
 
-			const std::size_t magic_index{ (occupancies[j].board() * magic_number) >> (MAX_BOARD_POSITIONS - m_rookBitCount[i]) };
+				tables.magic[offset + magic_index] = attack;
+				tables.pext[pext_offset + j] = attack;
+			}
 
-			m_rookAttackMask[i][magic_index] = attack;
+			offset += single_bit << (MAX_BOARD_POSITIONS - shift);
+			pext_offset += single_bit << bit_count;
 		}
 	}
-}
-
-
 
-// Magic Numbers
-void PreGen::InitMagicNumbers()
-{
-	if constexpr (USING_PREGENERATED_MAGICS)
+	constexpr SliderTables create_slider_tables()
 	{
-		std::cout << "Using Pregenerated Magics" << std::endl;
+		SliderTables tables{};
 
-		m_bishopMagics = pregen::bishop_magics;
-		m_rookMagics = pregen::rook_magics;
-	}
-	else
-	{
-		std::cout << "Not Using Pregenerated Magics" << std::endl;
+		std::size_t offset{};
+		std::size_t pext_offset{};
+		create_slider_attacks<Piece::BISHOP>(tables, offset, pext_offset);
+		create_slider_attacks<Piece::ROOK>(tables, offset, pext_offset);
 
-		createBishopMagics();
-		createRookMagics();
+		return tables;
 	}
 
-	if constexpr (PRINT_GENERATED_MAGICS)
+	constexpr std::size_t slider_table_size()
 	{
-		std::cout << std::endl << "Bishop Magics:" << std::endl;
-		for (std::size_t magic : m_bishopMagics)
-		{
-			std::cout << magic << "," << std::endl;
-		}
+		std::size_t table_size{};
 
-		std::cout << std::endl << "Rook Magics:" << std::endl;
-		for (std::size_t magic : m_rookMagics)
+		for (std::size_t i{}; i < MAX_BOARD_POSITIONS; i++)
 		{
-			std::cout << magic << "," << std::endl;
+			table_size += (single_bit << (MAX_BOARD_POSITIONS - pregen::bishop_shifts[i])) + (single_bit << (MAX_BOARD_POSITIONS - pregen::rook_shifts[i]));
 		}
-	}
-}
-
-void PreGen::createBishopMagics()
-{
-	std::cout << "Generating Bishop Magics";
 
-	for (std::size_t i{}; i < MAX_BOARD_POSITIONS; i++)
-	{
-		m_bishopMagics[i] = (findMagicNumber(i, Piece::BISHOP));
+		return table_size;
 	}
 
-	std::cout << " Done" << std::endl;
-}
+	constexpr std::size_t pext_table_size()
+	{
+		std::size_t table_size{};
 
-void PreGen::createRookMagics()
-{
-	std::cout << "Generating Rook Magics";
+		for (std::size_t i{}; i < MAX_BOARD_POSITIONS; i++)
+		{
+			table_size += (single_bit << bishop_bit_count[i]) + (single_bit << rook_bit_count[i]);
+		}
 
-	for (std::size_t i{}; i < MAX_BOARD_POSITIONS; i++)
-	{
-		m_rookMagics[i] = (findMagicNumber(i, Piece::ROOK));
+		return table_size;
 	}
 
-	std::cout << " Done" << std::endl;
-}
+	static_assert(slider_table_size() == pregen::slider_table_size, "pregen::slider_table_size has to match the shifts");
+	static_assert(pext_table_size() == PEXT_ATTACK_TABLE_SIZE, "PEXT_ATTACK_TABLE_SIZE has to match the relevant bit masks");
 
-std::vector<BitBoard> PreGen::createOccupancies(const std::uint64_t mask, const std::size_t num_bits, const std::size_t num_occupancies)
-{
-	std::vector<BitBoard> occupancies;
-	occupancies.reserve(num_occupancies); // Pre-allocate memory for all occupancies
 
-	for (std::uint64_t i{}; i < num_occupancies; i++)
+
+	// Lines
+	template<bool BETWEEN>
+	constexpr std::array<std::array<BitBoard, MAX_BOARD_POSITIONS>, MAX_BOARD_POSITIONS> create_line_masks()
 	{
-		BitBoard occupancy{};
-		std::size_t bit_position{}; // Position of set bits in the mask
+		std::array<std::array<BitBoard, MAX_BOARD_POSITIONS>, MAX_BOARD_POSITIONS> masks{};
 
-		// Iterate over each square on the board
-		for (std::size_t square{}; square < MAX_BOARD_POSITIONS; square++)
+		for (std::size_t a{}; a < MAX_BOARD_POSITIONS; a++)
 		{
-			// Check if the current square is in the mask
-			if (mask & (single_bit << square))
+			const BitBoard a_bit{ single_bit << a };
+			const BitBoard bishop_empty{ create_slider_attack<Piece::BISHOP>(a, BitBoard()) };
+			const BitBoard rook_empty{ create_slider_attack<Piece::ROOK>(a, BitBoard()) };
+
+			for (std::size_t b{}; b < MAX_BOARD_POSITIONS; b++)
 			{
-				// Check if the current bit in 'i' is set and set the corresponding square in occupancy
-				if (i & (single_bit << bit_position))
+				const BitBoard b_bit{ single_bit << b };
+
+				//each square blocks the other so the overlap of the two attacks is what lies between them
+				if (bishop_empty.test(b))
+				{
+					masks[a][b] = BETWEEN
+						? BitBoard{ create_slider_attack<Piece::BISHOP>(a, b_bit).board() & create_slider_attack<Piece::BISHOP>(b, a_bit).board() }
+						: BitBoard{ (bishop_empty.board() & create_slider_attack<Piece::BISHOP>(b, BitBoard()).board()) | a_bit.board() | b_bit.board() };
+				}
+				else if (rook_empty.test(b))
 				{
-					occupancy.set(square); // Set the corresponding square in the occupancy BitBoard
+					masks[a][b] = BETWEEN
+						? BitBoard{ create_slider_attack<Piece::ROOK>(a, b_bit).board() & create_slider_attack<Piece::ROOK>(b, a_bit).board() }
+						: BitBoard{ (rook_empty.board() & create_slider_attack<Piece::ROOK>(b, BitBoard()).board()) | a_bit.board() | b_bit.board() };
 				}
-				bit_position++;
 			}
 		}
 
-		occupancies.push_back(occupancy);
+		return masks;
 	}
 
-	return occupancies;
+	//every table starts on its own cache line, they are only ever read so all threads and engines can share them
+	alignas(64) constexpr std::array<std::array<BitBoard, MAX_BOARD_POSITIONS>, 2> pawn_attack_masks{ create_pawn_attack_masks() };
+	alignas(64) constexpr std::array<BitBoard, MAX_BOARD_POSITIONS> knight_attack_masks{ create_knight_attack_masks() };
+	alignas(64) constexpr std::array<BitBoard, MAX_BOARD_POSITIONS> king_attack_masks{ create_king_attack_masks() };
+	constexpr SliderTables slider_tables{ create_slider_tables() };
+	alignas(64) constexpr std::array<std::array<BitBoard, MAX_BOARD_POSITIONS>, MAX_BOARD_POSITIONS> between_masks{ create_line_masks<true>() };
+	alignas(64) constexpr std::array<std::array<BitBoard, MAX_BOARD_POSITIONS>, MAX_BOARD_POSITIONS> line_masks{ create_line_masks<false>() };
 }
 
-std::uint64_t PreGen::findMagicNumber(const std::size_t square, const Piece piece)
-{
-	Random rnd;
-
-	const std::uint64_t mask{ piece == Piece::BISHOP ? m_bishopRelevantBits[square].board() : m_rookRelevantBits[square].board() };
-
-	const std::size_t num_bits{ static_cast<std::size_t>(__popcnt64(mask)) };
-	const std::size_t num_occupancies{ single_bit << num_bits };
 
-	const std::vector<BitBoard> occupancies{ createOccupancies(mask, num_bits, num_occupancies) };
-	
-	while (true)
-	{
-		const std::uint64_t magic{ rnd.next_uint64_minbits() };
-
-		//skip inappropriate magic numbers
-		/*if (__popcnt64((mask * magic) & 0xFF00000000000000ULL) < 6)
-		{
-			continue;
-		}*/
 
-		bool bad_magic{ false };
-		std::bitset<MAX_ROOK_ATTACKS> index_tracker;
+const PreGen& PreGen::instance()
+{
+	//the tables are compile time data, so there is nothing to build on the first call
+	static const PreGen pre_gen;
+	return pre_gen;
+}
 
-		for (auto& occupancy : occupancies)
-		{
-			const std::size_t index{ static_cast<std::size_t>((occupancy.board() * magic) >> (MAX_BOARD_POSITIONS - num_bits)) };
+// Getters
+const std::array<std::array<BitBoard, MAX_BOARD_POSITIONS>, 2>& PreGen::pawnAttacks() const
+{
+	return pawn_attack_masks;
+}
 
-			//check if index exists
-			if (!index_tracker.test(index))
-			{
-				index_tracker.set(index);
-			}
-			else
-			{
-				bad_magic = true;
-				break;
-			}
-		}
+const std::array<BitBoard, MAX_BOARD_POSITIONS>& PreGen::knightAttacks() const
+{
+	return knight_attack_masks;
+}
 
-		if (!bad_magic)
-		{
-			return magic;
-		}
-	}
+const std::array<BitBoard, MAX_BOARD_POSITIONS>& PreGen::kingAttacks() const
+{
+	return king_attack_masks;
 }
 
-template<Piece P>
-BitBoard PreGen::createSliderAttack(const std::size_t square, const BitBoard occupancy)
+const std::array<BitBoard, pregen::slider_table_size>& PreGen::sliderAttacks() const
 {
-	BitBoard mask;
+	return slider_tables.magic;
+}
 
-	int tr{ static_cast<int>(square / 8) };
-	int tf{ static_cast<int>(square % 8) };
+const std::array<BitBoard, PEXT_ATTACK_TABLE_SIZE>& PreGen::sliderPextAttacks() const
+{
+	return slider_tables.pext;
+}
 
-	int r{};
-	int f{};
+const std::array<SliderMagic, MAX_BOARD_POSITIONS>& PreGen::bishopSliders() const
+{
+	return slider_tables.bishop;
+}
 
-	if constexpr (P == Piece::BISHOP)
-	{
-		for (r = tr + 1, f = tf + 1; r <= 7 && f <= 7; r++, f++)
-		{
-			mask.set_rf(r, f);
+const std::array<SliderMagic, MAX_BOARD_POSITIONS>& PreGen::rookSliders() const
+{
+	return slider_tables.rook;
+}
 
-			if (occupancy.test_rf(r, f))
-			{
-				break;
-			}
-		}
+const std::array<BitBoard, MAX_BOARD_POSITIONS>& PreGen::bishopRelevantBits() const
+{
+	return bishop_relevant_bits;
+}
 
-		for (r = tr + 1, f = tf - 1; r <= 7 && f >= 0; r++, f--)
-		{
-			mask.set_rf(r, f);
+const std::array<BitBoard, MAX_BOARD_POSITIONS>& PreGen::rookRelevantBits() const
+{
+	return rook_relevant_bits;
+}
 
-			if (occupancy.test_rf(r, f))
-			{
-				break;
-			}
-		}
+const std::array<std::uint64_t, MAX_BOARD_POSITIONS>& PreGen::bishopMagics() const
+{
+	return pregen::bishop_magics;
+}
 
-		for (r = tr - 1, f = tf - 1; r >= 0 && f >= 0; r--, f--)
-		{
-			mask.set_rf(r, f);
+const std::array<std::uint64_t, MAX_BOARD_POSITIONS>& PreGen::rookMagics() const
+{
+	return pregen::rook_magics;
+}
 
-			if (occupancy.test_rf(r, f))
-			{
-				break;
-			}
-		}
-		for (r = tr - 1, f = tf + 1; r >= 0 && f <= 7; r--, f++)
-		{
-			mask.set_rf(r, f);
+const std::array<std::size_t, MAX_BOARD_POSITIONS>& PreGen::bishopBitCount() const
+{
+	return bishop_bit_count;
+}
 
-			if (occupancy.test_rf(r, f))
-			{
-				break;
-			}
-		}
-	}
-	else
-	{
-		for (r = tr + 1; r <= 7; r++)
-		{
-			mask.set_rf(r, tf);
+const std::array<std::size_t, MAX_BOARD_POSITIONS>& PreGen::rookBitCount() const
+{
+	return rook_bit_count;
+}
 
-			if (occupancy.test_rf(r, tf))
-			{
-				break;
-			}
-		}
+const std::array<std::array<BitBoard, MAX_BOARD_POSITIONS>, MAX_BOARD_POSITIONS>& PreGen::betweenMasks() const
+{
+	return between_masks;
+}
 
-		for (r = tr - 1; r >= 0; r--)
-		{
-			mask.set_rf(r, tf);
+const std::array<std::array<BitBoard, MAX_BOARD_POSITIONS>, MAX_BOARD_POSITIONS>& PreGen::lineMasks() const
+{
+	return line_masks;
+}
 
-			if (occupancy.test_rf(r, tf))
-			{
-				break;
-			}
-		}
 
-		for (f = tf + 1; f <= 7; f++)
-		{
-			mask.set_rf(tr, f);
 
-			if (occupancy.test_rf(tr, f))
-			{
-				break;
-			}
-		}
+// Slider Attacks
+std::vector<BitBoard> PreGen::createOccupancies(const std::uint64_t mask, const std::size_t num_bits, const std::size_t num_occupancies)
+{
+	std::vector<BitBoard> occupancies;
+	occupancies.reserve(num_occupancies); // Pre-allocate memory for all occupancies
 
-		for (f = tf - 1; f >= 0; f--)
-		{
-			mask.set_rf(tr, f);
+	//occupancy i has the bits of i spread over the mask in square order
+	std::uint64_t occupancy{};
 
-			if (occupancy.test_rf(tr, f))
-			{
-				break;
-			}
-		}
+	for (std::uint64_t i{}; i < num_occupancies; i++, occupancy = (occupancy - mask) & mask)
+	{
+		occupancies.push_back(occupancy);
 	}
 
-	return mask;
+	return occupancies;
+}
+
+template<Piece P>
+BitBoard PreGen::createSliderAttack(const std::size_t square, const BitBoard occupancy) const
+{
+	return create_slider_attack<P>(square, occupancy);
 }
 
 
@@ -519,7 +489,7 @@ void PreGen::printMasks(const Piece P) const
 	if (P == Piece::KNIGHT)
 	{
 		int count{};
-		for (auto &b : m_knightAttackMasks)
+		for (auto &b : knight_attack_masks)
 		{
 			std::cout << "==========[" << count << "]==========" << std::endl;
 			b.print();
@@ -529,7 +499,7 @@ void PreGen::printMasks(const Piece P) const
 	else if (P == Piece::BISHOP)
 	{
 		int count{};
-		for (auto &b : m_bishopRelevantBits)
+		for (auto &b : bishop_relevant_bits)
 		{
 			std::cout << "==========[" << count << "]==========" << std::endl;
 			b.print();
@@ -539,7 +509,7 @@ void PreGen::printMasks(const Piece P) const
 	else if (P == Piece::ROOK)
 	{
 		int count{};
-		for (auto &b : m_rookRelevantBits)
+		for (auto &b : rook_relevant_bits)
 		{
 			std::cout << "==========[" << count << "]==========" << std::endl;
 			b.print();
@@ -553,7 +523,7 @@ void PreGen::printMasks(const Piece P) const
 	else if (P == Piece::KING)
 	{
 		int count{};
-		for (auto &b : m_kingAttackMasks)
+		for (auto &b : king_attack_masks)
 		{
 			std::cout << "==========[" << count << "]==========" << std::endl;
 			b.print();
@@ -562,8 +532,5 @@ void PreGen::printMasks(const Piece P) const
 	}
 }
 
-std::size_t PreGen::indexAttackTable(const std::size_t rank, const std::size_t file) 
-{
-	const std::size_t index{ rank * RANK_MAX + file };
-	return index;
-}
+template BitBoard PreGen::createSliderAttack<Piece::BISHOP>(const std::size_t square, const BitBoard occupancy) const;
+template BitBoard PreGen::createSliderAttack<Piece::ROOK>(const std::size_t square, const BitBoard occupancy) const;
\ No newline at end of file
@@ -6,44 +6,37 @@
 #include <vector>
 #include <intrin.h>
 #include <iostream>
-#include "Random.h"
 #include <unordered_set>
 #include "PregeneratedMagics.hpp"
 #include <bitset>
 #include <cstddef>
 
 
-class PreGen
+//everything a slider lookup needs for one square, 32 bytes so two squares share a cache line and none straddles two
+struct alignas(32) SliderMagic
 {
-private:
-	// Non Slider Attack Masks
-	std::array<std::array<BitBoard, MAX_BOARD_POSITIONS>, 2> m_pawnAttackMasks;
-	std::array<BitBoard, MAX_BOARD_POSITIONS> m_knightAttackMasks;
-	std::array<BitBoard, MAX_BOARD_POSITIONS> m_kingAttackMasks;
-
-	// Slider Attack Masks
-	std::array<std::array<BitBoard, MAX_BISHOP_ATTACKS>, MAX_BOARD_POSITIONS> m_bishopAttackMask;
-	std::array<std::array<BitBoard, MAX_ROOK_ATTACKS>, MAX_BOARD_POSITIONS> m_rookAttackMask;
+	std::uint64_t mask;
+	std::uint64_t magic;
+	std::uint32_t offset;
+	std::uint32_t shift;
 
-	std::array<BitBoard, MAX_BOARD_POSITIONS> m_bishopRelevantBits;
-	std::array<BitBoard, MAX_BOARD_POSITIONS> m_rookRelevantBits;
-
-	std::array<std::size_t, MAX_BOARD_POSITIONS> m_bishopBitCount;
-	std::array<std::size_t, MAX_BOARD_POSITIONS> m_rookBitCount;
-	
-	// Magic Numbers
-	std::array<std::uint64_t, MAX_BOARD_POSITIONS> m_bishopMagics;
-	std::array<std::uint64_t, MAX_BOARD_POSITIONS> m_rookMagics;
+	//a square can use fewer magic index bits than its mask has, so the PEXT table has its own offsets
+	std::uint32_t pextOffset;
+};
 
-	// Edges
-	BitBoard m_northEdgeMask;
-	BitBoard m_eastEdgeMask;
-	BitBoard m_southEdgeMask;
-	BitBoard m_westEdgeMask;
+//every table is built by constexpr functions in PreGen.cpp, so none of them cost anything at startup and they all live in read-only memory
+//there is only ever one PreGen and every MoveGen holds a reference to it
+class PreGen
+{
+private:
+	PreGen() = default;
 
 public:
+	PreGen(const PreGen&) = delete;
 
-	PreGen();
+	PreGen& operator=(const PreGen&) = delete;
+
+	static const PreGen& instance();
 
 	const std::array<std::array<BitBoard, MAX_BOARD_POSITIONS>, 2>& pawnAttacks() const;
 
@@ -51,59 +44,40 @@ public:
 
 	const std::array<BitBoard, MAX_BOARD_POSITIONS>& kingAttacks() const;
 
-	const std::array<std::array<BitBoard, MAX_BISHOP_ATTACKS>, MAX_BOARD_POSITIONS>& bishopAttacks() const;
-
-	const std::array<std::array<BitBoard, MAX_ROOK_ATTACKS>, MAX_BOARD_POSITIONS>& rookAttacks() const;
-
-	const std::array<std::uint64_t, MAX_BOARD_POSITIONS>& bishopMagics() const;
+	//both pieces share one table and every square owns a slice of 1 << (64 - shift) entries, bishops first then rooks
+	const std::array<BitBoard, pregen::slider_table_size>& sliderAttacks() const;
 
-	const std::array<std::uint64_t, MAX_BOARD_POSITIONS>& rookMagics() const;
+	//one entry for every subset of every mask, indexed by PEXT of the occupancy so no magic is needed
+	const std::array<BitBoard, PEXT_ATTACK_TABLE_SIZE>& sliderPextAttacks() const;
 
-	const std::array<std::size_t, MAX_BOARD_POSITIONS>& bishopBitCount() const;
+	const std::array<SliderMagic, MAX_BOARD_POSITIONS>& bishopSliders() const;
 
-	const std::array<std::size_t, MAX_BOARD_POSITIONS>& rookBitCount() const;
-	
+	const std::array<SliderMagic, MAX_BOARD_POSITIONS>& rookSliders() const;
 
+	const std::array<BitBoard, MAX_BOARD_POSITIONS>& bishopRelevantBits() const;
 
-	// Non Slider Piece Creation
-	void createPawnAttackMasks();
+	const std::array<BitBoard, MAX_BOARD_POSITIONS>& rookRelevantBits() const;
 
-	void createKnightAttackMasks();
-
-	void createKingAttackMasks();
-
-	void createEdgeMasks();
-
-
-
-	// Slider Piece Creation
-	void createBishopAttackMasks();
-
-	void createRookAttackMasks();
-
-	void createBishopBitCount();
-
-	void createRookBitCount();
+	const std::array<std::uint64_t, MAX_BOARD_POSITIONS>& bishopMagics() const;
 
-	void createBishopAttacks();
+	const std::array<std::uint64_t, MAX_BOARD_POSITIONS>& rookMagics() const;
 
-	void createRookAttacks();
+	const std::array<std::size_t, MAX_BOARD_POSITIONS>& bishopBitCount() const;
 
+	const std::array<std::size_t, MAX_BOARD_POSITIONS>& rookBitCount() const;
 
+	//between is the squares strictly between two aligned squares and line is the whole rank, file or diagonal through both
+	const std::array<std::array<BitBoard, MAX_BOARD_POSITIONS>, MAX_BOARD_POSITIONS>& betweenMasks() const;
 
-	// Magic Numbers
-	void InitMagicNumbers();
+	const std::array<std::array<BitBoard, MAX_BOARD_POSITIONS>, MAX_BOARD_POSITIONS>& lineMasks() const;
 
-	void createBishopMagics();
 
-	void createRookMagics();
 
+	// Slider Attacks, also used to check the tables and to search for new magics
 	static std::vector<BitBoard> createOccupancies(const std::uint64_t mask, const std::size_t num_bits, const std::size_t num_occupancies);
 
-	std::uint64_t findMagicNumber(const std::size_t square, const Piece piece);
-
 	template<Piece P>
-	BitBoard createSliderAttack(const std::size_t square, const BitBoard occupancy);
+	BitBoard createSliderAttack(const std::size_t square, const BitBoard occupancy) const;
 
 
 	
@@ -113,11 +87,11 @@ public:
 	{
 		if constexpr (P == Piece::BISHOP)
 		{
-			return occupancy.board() & m_bishopRelevantBits[square].board();
+			return occupancy.board() & bishopRelevantBits()[square].board();
 		}
 		else if constexpr (P == Piece::ROOK)
 		{
-			return occupancy.board() & m_rookRelevantBits[square].board();
+			return occupancy.board() & rookRelevantBits()[square].board();
 		}
 		else
 		{
@@ -125,7 +99,10 @@ public:
 		}
 	}
 
-	static std::size_t indexAttackTable(const std::size_t rank, const std::size_t file);
+	static constexpr std::size_t indexAttackTable(const std::size_t rank, const std::size_t file)
+	{
+		return rank * RANK_MAX + file;
+	}
 
 	void printMasks(Piece P) const;
-};
+};
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 #include <cstdint>
+#include <cstddef>
 #include <array>
 
+//written by ChessConsole.exe magics, the slider tables in PreGen.cpp are built from these at compile time
 namespace pregen
 {
 	constexpr std::array<std::uint64_t, 64> bishop_magics = {
@@ -36,7 +38,7 @@ namespace pregen
 		338052546877734916,
 		653023049783918885,
 		7319191275438596,
-		5768004060653495300,
+		2306134380890030208,
 		7532282093448995010,
 		903275810088685571,
 		793765095300924416,
@@ -71,7 +73,7 @@ namespace pregen
 		4620702091218798773
 	};
 
-	constexpr std::array<uint64_t, 64> rook_magics = {
+	constexpr std::array<std::uint64_t, 64> rook_magics = {
 		72075874517647618,
 		522426765189066752,
 		1188959235183087618,
@@ -137,4 +139,142 @@ namespace pregen
 		1153335067276294284,
 		9017096058975234
 	};
+
+	//the index is the top 64 - shift bits of the product, a square can use fewer bits than its mask when occupancies with the same attacks share an entry
+	constexpr std::array<std::uint32_t, 64> bishop_shifts = {
+		58,
+		59,
+		59,
+		59,
+		59,
+		59,
+		59,
+		58,
+		59,
+		59,
+		59,
+		59,
+		59,
+		59,
+		59,
+		59,
+		59,
+		59,
+		57,
+		57,
+		57,
+		57,
+		59,
+		59,
+		59,
+		59,
+		57,
+		55,
+		55,
+		57,
+		59,
+		59,
+		59,
+		59,
+		57,
+		55,
+		55,
+		57,
+		59,
+		59,
+		59,
+		59,
+		57,
+		57,
+		57,
+		57,
+		59,
+		59,
+		59,
+		59,
+		59,
+		59,
+		59,
+		59,
+		59,
+		59,
+		58,
+		59,
+		59,
+		59,
+		59,
+		59,
+		59,
+		58
+	};
+
+	constexpr std::array<std::uint32_t, 64> rook_shifts = {
+		52,
+		53,
+		53,
+		53,
+		53,
+		53,
+		53,
+		52,
+		53,
+		54,
+		54,
+		54,
+		54,
+		54,
+		54,
+		53,
+		53,
+		54,
+		54,
+		54,
+		54,
+		54,
+		54,
+		53,
+		53,
+		54,
+		54,
+		54,
+		54,
+		54,
+		54,
+		53,
+		53,
+		54,
+		54,
+		54,
+		54,
+		54,
+		54,
+		53,
+		53,
+		54,
+		54,
+		54,
+		54,
+		54,
+		54,
+		53,
+		53,
+		54,
+		54,
+		54,
+		54,
+		54,
+		54,
+		53,
+		52,
+		53,
+		53,
+		53,
+		53,
+		53,
+		53,
+		52
+	};
+
+	//entries in the magic slider table, every square owns 1 << (64 - shift) of them
+	constexpr std::size_t slider_table_size = 107648;
 }
\ No newline at end of file
@@ -1,70 +1,41 @@
 #include "Random.h"
 
 Random::Random()
-	: m_rng(std::time(NULL))
-{
-	srand(static_cast<unsigned int>(std::time(NULL)));
-}
+	: Random(static_cast<std::uint64_t>(std::time(nullptr))) {}
 
-std::uint64_t Random::next_uint64_minbits_mt()
+Random::Random(const std::uint64_t seed)
+	: m_state()
 {
-	const std::uint64_t p1{ m_rng() };
-	const std::uint64_t p2{ m_rng() };
-	const std::uint64_t p3{ m_rng() };
-	return p1 & p2;
-
-}
-
-std::uint32_t Random::next_uint32(const std::uint32_t max) const
-{
-	const std::uint16_t low_half{ static_cast<std::uint16_t>(max & 0xFFFF) };
-	const uint16_t high_half{ static_cast<std::uint32_t>((max >> 16) & 0xFFFF) };
-
-	const std::uint16_t p1{ static_cast<std::uint16_t>(rand() % low_half) };
-	const std::uint16_t p2{ static_cast<std::uint16_t>(rand() % high_half) };
-	const std::uint32_t shifted_p2{ static_cast<std::uint32_t>(p2) << 16};
-
-	const std::uint32_t rnd_uint{ p1 | shifted_p2 };
-	return rnd_uint;
+	//splitmix64 of the seed, so nearby seeds still start far apart and the state is never zero
+	std::uint64_t z{ seed + 0x9E3779B97F4A7C15 };
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+	m_state = (z ^ (z >> 31)) | 1;
 }
 
-std::uint64_t Random::next_uint64() const
+std::uint32_t Random::next_uint32(const std::uint32_t max)
 {
-	const std::uint32_t p1{ next_uint32(UINT32_MAX) };
-	const std::uint32_t p2{ next_uint32(UINT32_MAX) };
-	const std::uint64_t shifted_p2{ static_cast<std::uint64_t>(p2) << 32 };
-
-	const std::uint64_t rnd_u64{ shifted_p2 | p1 };
+	//the high half of a 32 by 32 bit multiply maps the draw onto [0, max) without a modulo
+	const std::uint64_t draw{ next_uint64() >> 32 };
 
-	return rnd_u64;
+	return static_cast<std::uint32_t>((draw * max) >> 32);
 }
 
-BitBoard Random::next_bitboard() const
+std::uint64_t Random::next_uint64()
 {
-	const std::uint64_t rnd_bitset{ next_uint64() };
+	m_state ^= m_state >> 12;
+	m_state ^= m_state << 25;
+	m_state ^= m_state >> 27;
 
-	BitBoard board;
-	board.setBoard(rnd_bitset);
-
-	return board;
+	return m_state * 0x2545F4914F6CDD1D;
 }
 
-BitBoard Random::next_bitboard_minbits_mt()
+BitBoard Random::next_bitboard()
 {
-	const std::uint64_t rnd_bits = next_uint64_minbits_mt();
-
-	BitBoard board;
-	board.setBoard(rnd_bits);
-
-	return board;
+	return BitBoard{ next_uint64() };
 }
 
-std::uint64_t Random::next_uint64_minbits() const
+std::uint64_t Random::next_uint64_minbits()
 {
-	const std::uint64_t p1{ next_uint64() };
-	const std::uint64_t p2{ next_uint64() };
-
-	const std::uint64_t rnd_minbits{ p1 & p2 };
-
-	return rnd_minbits;
+	return next_uint64() & next_uint64() & next_uint64();
 }
\ No newline at end of file
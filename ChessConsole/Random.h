@@ -1,29 +1,28 @@
 #pragma once
 
 #include <ctime>
-#include <cstdlib>
 #include <cstdint>
 #include "ChessConstants.hpp"
 #include "BitBoard.h"
-#include <random>
 
+//xorshift64*, small and fast enough to give every thread its own stream
 class Random
 {
 private:
-	std::mt19937_64 m_rng;
+	std::uint64_t m_state;
 
 public:
 	Random();
 
-	std::uint32_t next_uint32(const std::uint32_t max)  const;
+	Random(const std::uint64_t seed);
 
-	std::uint64_t next_uint64() const;
+	//uniform in [0, max), 0 when max is 0
+	std::uint32_t next_uint32(const std::uint32_t max);
 
-	BitBoard next_bitboard() const;
+	std::uint64_t next_uint64();
 
-	BitBoard next_bitboard_minbits_mt();
+	BitBoard next_bitboard();
 
-	std::uint64_t next_uint64_minbits() const;
-
-	std::uint64_t next_uint64_minbits_mt();
+	//roughly one bit in eight set, good magic numbers tend to be sparse
+	std::uint64_t next_uint64_minbits();
 };
\ No newline at end of file
@@ -0,0 +1,624 @@
+#include "SearchThread.h"
+
+namespace
+{
+	//std::log is not constexpr, halving into [1, 2) leaves a series that converges in a few terms
+	constexpr double constexpr_ln(double x)
+	{
+		constexpr double ln_2{ 0.6931471805599453 };
+		double result{};
+
+		while (x >= 2.0)
+		{
+			x /= 2.0;
+			result += ln_2;
+		}
+
+		//ln(x) = 2 atanh((x - 1) / (x + 1))
+		const double z{ (x - 1.0) / (x + 1.0) };
+		double power{ z };
+
+		for (int k{}; k < 16; k++)
+		{
+			result += 2.0 * power / (2 * k + 1);
+			power *= z * z;
+		}
+
+		return result;
+	}
+
+	//late move reduction in plies by [depth][moves searched], grows with both so deep nodes cut the tail of the list hardest
+	constexpr std::array<std::array<std::uint8_t, LMR_MAX_MOVES>, MAX_SEARCH_PLY> create_lmr_reductions()
+	{
+		std::array<std::array<std::uint8_t, LMR_MAX_MOVES>, MAX_SEARCH_PLY> reductions{};
+
+		for (std::size_t depth{ 1 }; depth < MAX_SEARCH_PLY; depth++)
+		{
+			for (std::size_t moves{ 1 }; moves < LMR_MAX_MOVES; moves++)
+			{
+				reductions[depth][moves] = static_cast<std::uint8_t>(0.75 + constexpr_ln(static_cast<double>(depth)) * constexpr_ln(static_cast<double>(moves)) / 2.25);
+			}
+		}
+
+		return reductions;
+	}
+
+	constexpr std::array<std::array<std::uint8_t, LMR_MAX_MOVES>, MAX_SEARCH_PLY> lmr_reductions = create_lmr_reductions();
+}
+
+SearchStats& SearchStats::operator+=(const SearchStats& other)
+{
+	nodes += other.nodes;
+	evaluations += other.evaluations;
+	prunes += other.prunes;
+	mates += other.mates;
+	ttHits += other.ttHits;
+	ttCutoffs += other.ttCutoffs;
+	quiescenceNodes += other.quiescenceNodes;
+	nullMoveCutoffs += other.nullMoveCutoffs;
+	aspirationSearches += other.aspirationSearches;
+	aspirationFailLows += other.aspirationFailLows;
+	aspirationFailHighs += other.aspirationFailHighs;
+
+	return *this;
+}
+
+SearchThread::SearchThread(const std::size_t id, const MoveGen& moveGen, TranspositionTable& transpositionTable, std::atomic<bool>& stopSearch)
+	: m_moveGen(moveGen), m_transpositionTable(transpositionTable), m_stopSearch(stopSearch), m_id(id), m_stack(), m_stats(), m_history(), m_counterMoves(), 
+	m_principalVariation(), m_followPv(), m_verifyingNull(), m_depth(), m_depthSearched(), m_timeLimited(), m_timeCheckCount(), m_searchStartTime() {}
+
+void SearchThread::iterativeMinimax(const State& state, const std::uint32_t max_depth, const bool time_limited)
+{
+	m_searchStartTime = std::chrono::steady_clock::now();
+	m_timeLimited = time_limited;
+	m_timeCheckCount = 0;
+	m_principalVariation.clear();
+	m_depthSearched = 0;
+
+	for (SearchStack& stack : m_stack)
+	{
+		stack.killers.fill(Move());
+	}
+
+	m_history = HistoryTable();
+	m_counterMoves = {};
+
+	//lazy smp, odd helper threads run one ply ahead so the threads fill the table for different depths
+	std::uint32_t depth{ 1 + static_cast<std::uint32_t>(m_id % 2) };
+	const std::uint32_t depth_limit{ std::min<std::uint32_t>(max_depth, MAX_SEARCH_PLY - 1) };
+
+	//the search plays moves on its own copy
+	State root{ state };
+	int score{};
+
+	while (!m_stopSearch.load(std::memory_order_relaxed) && depth <= depth_limit)
+	{
+		m_depth = depth;
+
+		int alpha{ -INFINITE_SCORE };
+		int beta{ INFINITE_SCORE };
+		int window{ ASPIRATION_WINDOW };
+
+		//aspiration window, the last iteration's score is usually close so most of the tree only has to be searched against a narrow window
+		if (depth >= ASPIRATION_MIN_DEPTH && std::abs(score) < CHECKMATE_THRESHOLD)
+		{
+			m_stats.aspirationSearches++;
+			alpha = score - window;
+			beta = score + window;
+		}
+
+		while (true)
+		{
+			m_followPv = true;
+			score = searchRoot(root, depth, alpha, beta);
+
+			if (m_stopSearch.load(std::memory_order_relaxed))
+			{
+				break;
+			}
+
+			//the score is only a bound outside the window, widen the side it fell through and search again
+			if (score <= alpha)
+			{
+				m_stats.aspirationFailLows++;
+				alpha = std::max(score - window, -INFINITE_SCORE);
+			}
+			else if (score >= beta)
+			{
+				m_stats.aspirationFailHighs++;
+				beta = std::min(score + window, INFINITE_SCORE);
+			}
+			else
+			{
+				break;
+			}
+
+			window *= 2;
+		}
+
+		if (!m_stopSearch.load(std::memory_order_relaxed))
+		{
+			m_principalVariation.clear();
+
+			for (std::size_t i{}; i < m_stack[0].pvLength; i++)
+			{
+				m_principalVariation.addMove(m_stack[0].pv[i]);
+			}
+
+			m_depthSearched = depth;
+		}
+
+		depth++;
+	}
+}
+
+int SearchThread::searchRoot(State& root, const std::uint32_t depth, const int alpha, const int beta)
+{
+	if (root.whiteToMove())
+	{
+		return negamax<Color::WHITE>(root, depth, alpha, beta, 0);
+	}
+
+	return negamax<Color::BLACK>(root, depth, alpha, beta, 0);
+}
+
+int SearchThread::evaluate(const State& state)
+{
+	m_stats.evaluations++;
+
+	int evaluation{};
+
+	for (std::size_t piece{}; piece < PIECE_COUNT; piece++)
+	{
+		BitBoard piece_board = state.positions()[piece];
+
+		while (piece_board.board())
+		{
+			const std::size_t square = piece_board.find_1lsb();
+			const BitBoard attack = m_moveGen.getPieceAttack(piece, square, state);
+
+			evaluation += piece_value[piece];
+			evaluation += static_cast<int>(attack.bitCount());
+
+			piece_board.reset(square);
+		}
+	}
+
+	return evaluation;
+}
+
+template<Color C>
+int SearchThread::negamax(State& state, const std::uint32_t depth, int alpha, int beta, const std::uint32_t ply)
+{
+	m_stats.nodes++;
+
+	SearchStack& stack{ m_stack[ply] };
+	stack.pvLength = 0;
+	stack.nullMove = false;
+
+	if (depth == 0)
+	{
+		return quiescence<C>(state, alpha, beta, ply);
+	}
+
+	//time cutoff for iterative deepening, the score is thrown away by every caller
+	if (m_stopSearch.load(std::memory_order_relaxed))
+	{
+		return 0;
+	}
+
+	if (outOfTime())
+	{
+		m_stopSearch.store(true, std::memory_order_relaxed);
+		return 0;
+	}
+
+	const std::uint64_t hash{ state.hash() };
+	const int original_alpha{ alpha };
+
+	//anything wider than a null window can still change the principal variation
+	const bool pv_node{ beta - alpha > 1 };
+
+	//transposition table lookup, never cut on a pv node so the root always has a move and the line reaches the horizon
+	TTEntry entry;
+	Move tt_move;
+
+	if (m_transpositionTable.probe(hash, entry))
+	{
+		m_stats.ttHits++;
+		tt_move = entry.move;
+
+		if (!pv_node && entry.depth >= depth)
+		{
+			const int tt_score{ TranspositionTable::scoreFromTT(entry.score, ply) };
+
+			if (entry.bound == Bound::EXACT
+				|| (entry.bound == Bound::LOWER && tt_score >= beta)
+				|| (entry.bound == Bound::UPPER && tt_score <= alpha))
+			{
+				m_stats.ttCutoffs++;
+				return tt_score;
+			}
+		}
+	}
+
+	const bool in_check{ m_moveGen.kingInCheck<C>(state) };
+
+	//null move pruning, if passing still fails high against a shallower search a real move will too
+	if (!pv_node && !in_check && depth >= NULL_MOVE_MIN_DEPTH && !m_verifyingNull && !(ply != 0 && m_stack[ply - 1].nullMove)
+		&& hasNonPawnMaterial<C>(state))
+	{
+		const std::uint32_t reduction{ NULL_MOVE_REDUCTION + depth / NULL_MOVE_REDUCTION_STEP };
+		const std::uint32_t null_depth{ depth > reduction ? depth - 1 - reduction : 0 };
+
+		stack.nullMove = true;
+		stack.move = Move();
+		state.makeNullMove(stack.undo);
+		const int null_eval{ -negamax<other_color(C)>(state, null_depth, -beta, -beta + 1, ply + 1) };
+		state.unmakeNullMove(stack.undo);
+		stack.nullMove = false;
+
+		if (m_stopSearch.load(std::memory_order_relaxed))
+		{
+			return 0;
+		}
+
+		if (null_eval >= beta)
+		{
+			//deep cutoffs are checked with a normal search that may not pass, so zugzwang positions are not cut
+			bool verified{ true };
+
+			if (depth >= NULL_MOVE_VERIFY_DEPTH)
+			{
+				m_verifyingNull = true;
+				verified = negamax<C>(state, null_depth, beta - 1, beta, ply) >= beta;
+				m_verifyingNull = false;
+			}
+
+			if (verified)
+			{
+				m_stats.nullMoveCutoffs++;
+
+				//a mate found after passing is not a real mate
+				return null_eval >= CHECKMATE_THRESHOLD ? beta : null_eval;
+			}
+		}
+	}
+
+	//the first line of every iteration walks down the principal variation of the last one
+	if (m_followPv && ply < m_principalVariation.count())
+	{
+		tt_move = m_principalVariation.moves()[ply];
+	}
+	else
+	{
+		m_followPv = false;
+	}
+
+	const Move previous_move{ ply != 0 ? m_stack[ply - 1].move : Move() };
+	const Move counter_move{ previous_move.data() ? m_counterMoves[previous_move.source()][previous_move.target()] : Move() };
+
+	MovePicker<C> picker{ m_moveGen, state, stack.moves, stack.badCaptures, tt_move, stack.killers, counter_move, m_history };
+	Move move;
+
+	int best_eval{ -INFINITE_SCORE };
+	Move best_move;
+	std::size_t moves_searched{};
+	stack.quietCount = 0;
+
+	while (picker.next(move))
+	{
+		const bool quiet{ !move.capture() && !move.promoted() };
+
+		//every move the picker hands out is legal
+		stack.move = move;
+		state.makeMove(move, stack.undo);
+		state.flipSide();
+
+		int eval;
+
+		//principal variation search, the first move gets the full window and the rest only have to prove they are no better
+		if (moves_searched == 0)
+		{
+			eval = -negamax<other_color(C)>(state, depth - 1, -beta, -alpha, ply + 1);
+		}
+		else
+		{
+			std::uint32_t reduction{};
+
+			//late move reductions, quiet moves this far down the list rarely beat alpha so their scout is shallower
+			if (depth >= LMR_MIN_DEPTH && moves_searched >= LMR_MIN_MOVES && !in_check && quiet)
+			{
+				int table_reduction{ lmr_reductions[depth][std::min(moves_searched, LMR_MAX_MOVES - 1)] };
+
+				//moves that have cut often elsewhere are reduced less, ones that keep failing more
+				table_reduction -= m_history[C][move.source()][move.target()] / HISTORY_LMR_DIVISOR;
+
+				//pv nodes and checking moves are more likely to change the score
+				if (pv_node)
+				{
+					table_reduction--;
+				}
+
+				if (m_moveGen.kingInCheck<other_color(C)>(state))
+				{
+					table_reduction--;
+				}
+
+				reduction = static_cast<std::uint32_t>(std::clamp(table_reduction, 0, static_cast<int>(depth) - 2));
+			}
+
+			eval = -negamax<other_color(C)>(state, depth - 1 - reduction, -alpha - 1, -alpha, ply + 1);
+
+			//a reduced move that beats alpha has to show it at full depth
+			if (reduction && alpha < eval)
+			{
+				eval = -negamax<other_color(C)>(state, depth - 1, -alpha - 1, -alpha, ply + 1);
+			}
+
+			if (alpha < eval && eval < beta)
+			{
+				eval = -negamax<other_color(C)>(state, depth - 1, -beta, -alpha, ply + 1);
+			}
+		}
+
+		state.flipSide();
+		state.unmakeMove(move, stack.undo);
+
+		moves_searched++;
+		m_followPv = false;
+
+		//time cutoff for iterative deepening
+		if (m_stopSearch.load(std::memory_order_relaxed))
+		{
+			return 0;
+		}
+
+		if (eval > best_eval)
+		{
+			best_eval = eval;
+			best_move = move;
+		}
+
+		if (alpha < eval)
+		{
+			alpha = eval;
+			updatePv(move, ply);
+		}
+
+		if (beta <= alpha)
+		{
+			m_stats.prunes++;
+
+			if (quiet)
+			{
+				storeQuietCutoff<C>(move, depth, ply);
+			}
+
+			break;
+		}
+
+		if (quiet && stack.quietCount < MAX_QUIETS_SEARCHED)
+		{
+			stack.quietsSearched[stack.quietCount++] = move;
+		}
+	}
+
+	if (moves_searched == 0)
+	{
+		if (in_check)
+		{
+			//checkmate, prefer the longest way to get mated
+			m_stats.mates++;
+			best_eval = -CHECKMATE_SCORE + static_cast<int>(ply);
+		}
+		else
+		{
+			//stalemate
+			best_eval = 0;
+		}
+	}
+
+	//a score at or below the window we were given is only an upper bound, one at or above beta only a lower bound
+	Bound bound{ Bound::EXACT };
+
+	if (best_eval <= original_alpha)
+	{
+		bound = Bound::UPPER;
+	}
+	else if (best_eval >= beta)
+	{
+		bound = Bound::LOWER;
+	}
+
+	m_transpositionTable.store(hash, depth, bound, TranspositionTable::scoreToTT(best_eval, ply), best_move);
+
+	return best_eval;
+}
+
+template<Color C>
+int SearchThread::quiescence(State& state, int alpha, int beta, const std::uint32_t ply)
+{
+	m_stats.nodes++;
+	m_stats.quiescenceNodes++;
+
+	if (m_stopSearch.load(std::memory_order_relaxed) || ply >= MAX_SEARCH_PLY - 1)
+	{
+		return C == Color::WHITE ? evaluate(state) : -evaluate(state);
+	}
+
+	//a side in check can not stand pat, it has to answer the check so every evasion is searched
+	const bool in_check{ m_moveGen.kingInCheck<C>(state) };
+	int best_eval{ -INFINITE_SCORE };
+	int stand_pat{};
+
+	if (!in_check)
+	{
+		//stand pat, the side to move is assumed to have at least one quiet move that keeps the static score
+		stand_pat = C == Color::WHITE ? evaluate(state) : -evaluate(state);
+
+		if (stand_pat >= beta)
+		{
+			return stand_pat;
+		}
+
+		//delta pruning, not even winning a queen gets us back to alpha
+		if (stand_pat + piece_value[Piece::QUEEN] + DELTA_PRUNING_MARGIN < alpha)
+		{
+			return stand_pat;
+		}
+
+		alpha = std::max(alpha, stand_pat);
+		best_eval = stand_pat;
+	}
+
+	SearchStack& stack{ m_stack[ply] };
+	MovePicker<C> picker{ in_check
+		? MovePicker<C>{ m_moveGen, state, stack.moves, stack.badCaptures, Move(), stack.killers, Move(), m_history }
+		: MovePicker<C>{ m_moveGen, state, stack.moves, stack.badCaptures } };
+	Move move;
+	bool any_legal_moves{ false };
+
+	while (picker.next(move))
+	{
+		any_legal_moves = true;
+
+		//delta pruning per capture, promotions are never pruned because they also gain material
+		if (!in_check && !move.promoted())
+		{
+			const Piece captured{ move.enpassant() ? Piece::PAWN : state.testPieceType(move.target()) };
+			const int gain{ piece_value[captured % 6] + DELTA_PRUNING_MARGIN };
+
+			if (stand_pat + gain <= alpha)
+			{
+				continue;
+			}
+		}
+
+		state.makeMove(move, stack.undo);
+		state.flipSide();
+		const int eval{ -quiescence<other_color(C)>(state, -beta, -alpha, ply + 1) };
+		state.flipSide();
+		state.unmakeMove(move, stack.undo);
+
+		best_eval = std::max(best_eval, eval);
+		alpha = std::max(alpha, eval);
+
+		if (beta <= alpha)
+		{
+			m_stats.prunes++;
+			break;
+		}
+	}
+
+	//checkmate, scored like in negamax so mates at the horizon are seen
+	if (in_check && !any_legal_moves)
+	{
+		m_stats.mates++;
+		return -CHECKMATE_SCORE + static_cast<int>(ply);
+	}
+
+	return best_eval;
+}
+
+Move SearchThread::bestMove() const
+{
+	return m_principalVariation.count() ? m_principalVariation.moves()[0] : Move();
+}
+
+const MoveList& SearchThread::principalVariation() const
+{
+	return m_principalVariation;
+}
+
+std::uint32_t SearchThread::depthSearched() const
+{
+	return m_depthSearched;
+}
+
+const SearchStats& SearchThread::stats() const
+{
+	return m_stats;
+}
+
+template<Color C>
+void SearchThread::storeQuietCutoff(const Move move, const std::uint32_t depth, const std::uint32_t ply)
+{
+	SearchStack& stack{ m_stack[ply] };
+	std::array<Move, MAX_KILLER_MOVES>& killers{ stack.killers };
+
+	if (killers[0] != move)
+	{
+		std::copy_backward(killers.begin(), killers.end() - 1, killers.end());
+		killers[0] = move;
+	}
+
+	if (ply != 0 && m_stack[ply - 1].move.data())
+	{
+		const Move previous_move{ m_stack[ply - 1].move };
+		m_counterMoves[previous_move.source()][previous_move.target()] = move;
+	}
+
+	//deeper cutoffs say more about the move
+	const int bonus{ std::min(static_cast<int>(64 * depth * depth), HISTORY_MAX_BONUS) };
+
+	updateHistory(m_history[C][move.source()][move.target()], bonus);
+
+	for (std::size_t i{}; i < stack.quietCount; i++)
+	{
+		const Move quiet{ stack.quietsSearched[i] };
+		updateHistory(m_history[C][quiet.source()][quiet.target()], -bonus);
+	}
+}
+
+void SearchThread::updateHistory(int& history, const int bonus)
+{
+	history += bonus - history * std::abs(bonus) / HISTORY_MAX;
+}
+
+void SearchThread::updatePv(const Move move, const std::uint32_t ply)
+{
+	SearchStack& stack{ m_stack[ply] };
+	const SearchStack& child{ m_stack[ply + 1] };
+
+	stack.pv[0] = move;
+	std::copy_n(child.pv.begin(), child.pvLength, stack.pv.begin() + 1);
+	stack.pvLength = child.pvLength + 1;
+}
+
+template<Color C>
+bool SearchThread::hasNonPawnMaterial(const State& state)
+{
+	constexpr std::size_t offset{ C == Color::WHITE ? 0 : Piece::BPAWN };
+	const std::array<BitBoard, 12>& positions{ state.positions() };
+
+	return (positions[Piece::KNIGHT + offset].board() | positions[Piece::BISHOP + offset].board()
+		| positions[Piece::ROOK + offset].board() | positions[Piece::QUEEN + offset].board()) != 0;
+}
+
+bool SearchThread::outOfTime()
+{
+	//only the main thread watches the clock, helpers stop when it raises the flag
+	if (m_id != 0 || !m_timeLimited)
+	{
+		return false;
+	}
+
+	//only test time every 1000 nodes to avoid frequent system calls
+	if (m_timeCheckCount >= TIME_EVALUATION_NODE_DELAY)
+	{
+		const auto now{ std::chrono::steady_clock::now() };
+		const std::chrono::duration<float> duration{ now - m_searchStartTime };
+
+		if (static_cast<size_t>(duration.count()) >= MAX_EVALUATION_TIME_SECONDS)
+		{
+			return true;
+		}
+
+		m_timeCheckCount = 0;
+	}
+
+	m_timeCheckCount++;
+
+	return false;
+}
\ No newline at end of file
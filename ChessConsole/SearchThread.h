@@ -0,0 +1,133 @@
+#pragma once
+
+#include "MoveGen.h"
+#include "MovePicker.h"
+#include "TranspositionTable.h"
+#include "ChessConstants.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+
+struct SearchStats
+{
+	std::uint64_t nodes;
+	std::uint64_t evaluations;
+	std::uint64_t prunes;
+	std::uint64_t mates;
+	std::uint64_t ttHits;
+	std::uint64_t ttCutoffs;
+	std::uint64_t quiescenceNodes;
+	std::uint64_t nullMoveCutoffs;
+
+	//iterations started with an aspiration window and how often it had to be widened
+	std::uint64_t aspirationSearches;
+	std::uint64_t aspirationFailLows;
+	std::uint64_t aspirationFailHighs;
+
+	SearchStats& operator+=(const SearchStats& other);
+};
+
+//per ply scratch space, reused every time the search reaches that ply
+struct SearchStack
+{
+	MoveList moves;
+	MoveList badCaptures;
+
+	//the move being searched from this ply, taken back in place afterwards, empty while a null move is searched
+	Move move;
+	UndoInfo undo;
+
+	//quiet moves already searched at this ply that did not cut, they lose history when a later one does
+	std::array<Move, MAX_QUIETS_SEARCHED> quietsSearched;
+	std::size_t quietCount;
+
+	//the side at this ply passed, so the ply below may not pass straight back
+	bool nullMove;
+
+	//quiet moves that caused a beta cutoff at this ply, newest first
+	std::array<Move, MAX_KILLER_MOVES> killers;
+
+	//best line found from this ply down, the stacks together make up the triangular pv table
+	std::array<Move, MAX_SEARCH_PLY> pv;
+	std::size_t pvLength;
+};
+
+class SearchThread
+{
+private:
+	//shared between every thread of an engine
+	const MoveGen& m_moveGen;
+	TranspositionTable& m_transpositionTable;
+	std::atomic<bool>& m_stopSearch;
+
+	//owned by this thread
+	const std::size_t m_id;
+	std::array<SearchStack, MAX_SEARCH_PLY> m_stack;
+	SearchStats m_stats;
+
+	//quiet move ordering, both start empty every search
+	HistoryTable m_history;
+
+	//[source][target] of the opponent's last move, the quiet move that refuted it
+	std::array<std::array<Move, MAX_BOARD_POSITIONS>, MAX_BOARD_POSITIONS> m_counterMoves;
+
+	//line of the last completed iteration, the next iteration searches it first
+	MoveList m_principalVariation;
+	bool m_followPv;
+
+	//set while a null move cutoff is being verified, no null moves are tried below it
+	bool m_verifyingNull;
+
+	std::uint32_t m_depth;
+	std::uint32_t m_depthSearched;
+
+	bool m_timeLimited;
+	std::size_t m_timeCheckCount;
+	std::chrono::steady_clock::time_point m_searchStartTime;
+
+public:
+	SearchThread(const std::size_t id, const MoveGen& moveGen, TranspositionTable& transpositionTable, std::atomic<bool>& stopSearch);
+
+	void iterativeMinimax(const State& state, const std::uint32_t max_depth, const bool time_limited);
+
+	//C is the side to move and every score is from its point of view, so one body searches for both sides
+	template<Color C>
+	int negamax(State& state, const std::uint32_t depth, int alpha, int beta, const std::uint32_t ply);
+
+	//captures only search below the horizon so leaves are never scored in the middle of an exchange
+	template<Color C>
+	int quiescence(State& state, int alpha, int beta, const std::uint32_t ply);
+
+	int evaluate(const State& state);
+
+	Move bestMove() const;
+
+	const MoveList& principalVariation() const;
+
+	std::uint32_t depthSearched() const;
+
+	const SearchStats& stats() const;
+
+private:
+	//one iteration from the root with the given window, dispatched on the side to move
+	int searchRoot(State& root, const std::uint32_t depth, const int alpha, const int beta);
+
+	//a quiet move caused a beta cutoff, it becomes a killer and the counter move, and gains history at the expense of the quiets tried before it
+	template<Color C>
+	void storeQuietCutoff(const Move move, const std::uint32_t depth, const std::uint32_t ply);
+
+	//gravity update, the closer the score already is to HISTORY_MAX the less a bonus moves it
+	static void updateHistory(int& history, const int bonus);
+
+	//true when the side has a piece other than pawns and the king, without one a pass can be better than every move
+	template<Color C>
+	static bool hasNonPawnMaterial(const State& state);
+
+	//move followed by the line of the ply below it
+	void updatePv(const Move move, const std::uint32_t ply);
+
+	bool outOfTime();
+};
\ No newline at end of file
@@ -1,15 +1,22 @@
 #include "State.h"
 
 State::State()
-	: m_positions(), m_occupancy(), m_whiteToMove(true), m_enpassantSquare(no_sqr), m_castleRights(0b1111) {}
+	: m_positions(), m_occupancy(), m_mailbox(), m_whiteToMove(true), m_enpassantSquare(no_sqr), m_castleRights(0b1111), 
+	m_hash(zobrist::keys.castle[0b1111]), m_pawnHash() 
+{
+	m_mailbox.fill(Piece::NO_PIECE);
+}
 
 
 State::State(const State& state)
 	: m_positions(state.m_positions), 
 	m_occupancy(state.m_occupancy),
+	m_mailbox(state.m_mailbox),
 	m_whiteToMove(state.m_whiteToMove), 
-	m_enpassantSquare(no_sqr), //always gets reset to no square
-	m_castleRights(state.m_castleRights) 
+	m_enpassantSquare(state.m_enpassantSquare),
+	m_castleRights(state.m_castleRights),
+	m_hash(state.m_hash),
+	m_pawnHash(state.m_pawnHash)
 {}
 
 std::uint8_t State::castleRights() const
@@ -19,7 +26,9 @@ std::uint8_t State::castleRights() const
 
 void State::setCastleRights(std::size_t square)
 {
+	m_hash ^= zobrist::keys.castle[m_castleRights];
 	m_castleRights &= castling_rights[square];
+	m_hash ^= zobrist::keys.castle[m_castleRights];
 }
 
 const std::array<BitBoard, 12>& State::positions() const
@@ -39,15 +48,7 @@ std::size_t State::enpassantSquare() const
 
 Piece State::testPieceType(const std::size_t square) const
 {
-	for (std::size_t piece{}; piece < PIECE_COUNT; piece++)
-	{
-		if (m_positions[piece].test(square))
-		{
-			return static_cast<Piece>(piece);
-		}
-	}
-
-	return Piece::NO_PIECE;
+	return m_mailbox[square];
 }
 
 bool State::testCastleRights(const Castle C) const
@@ -57,7 +58,10 @@ bool State::testCastleRights(const Castle C) const
 
 void State::setEnpassantSquare(const std::size_t square)
 {
+	//no_sqr has a key of 0 so clearing and setting are both a single xor
+	m_hash ^= zobrist::keys.enpassant[m_enpassantSquare];
 	m_enpassantSquare = square;
+	m_hash ^= zobrist::keys.enpassant[m_enpassantSquare];
 }
 
 bool State::whiteToMove() const
@@ -68,6 +72,63 @@ bool State::whiteToMove() const
 void State::flipSide()
 {
 	m_whiteToMove = !m_whiteToMove;
+	m_hash ^= zobrist::keys.side;
+}
+
+std::uint64_t State::hash() const
+{
+	return m_hash;
+}
+
+std::uint64_t State::pawnHash() const
+{
+	return m_pawnHash;
+}
+
+std::uint64_t State::generateHash() const
+{
+	std::uint64_t hash{};
+
+	for (std::size_t piece{}; piece < PIECE_COUNT; piece++)
+	{
+		BitBoard board{ m_positions[piece] };
+
+		while (board.board())
+		{
+			const std::size_t square{ board.find_1lsb() };
+			hash ^= zobrist::keys.pieces[piece][square];
+			board.reset(square);
+		}
+	}
+
+	hash ^= zobrist::keys.castle[m_castleRights];
+	hash ^= zobrist::keys.enpassant[m_enpassantSquare];
+
+	if (!m_whiteToMove)
+	{
+		hash ^= zobrist::keys.side;
+	}
+
+	return hash;
+}
+
+std::uint64_t State::generatePawnHash() const
+{
+	std::uint64_t hash{};
+
+	for (const Piece piece : { Piece::PAWN, Piece::BPAWN })
+	{
+		BitBoard board{ m_positions[piece] };
+
+		while (board.board())
+		{
+			const std::size_t square{ board.find_1lsb() };
+			hash ^= zobrist::keys.pieces[piece][square];
+			board.reset(square);
+		}
+	}
+
+	return hash;
 }
 
 void State::setPiece(const Piece P, const std::size_t square)
@@ -75,6 +136,14 @@ void State::setPiece(const Piece P, const std::size_t square)
 	m_positions[static_cast<size_t>(P)].set(square);
 	m_occupancy[static_cast<size_t>(P / 6)].set(square);
 	m_occupancy[Occupancy::BOTH].set(square);
+	m_mailbox[square] = P;
+
+	m_hash ^= zobrist::keys.pieces[P][square];
+
+	if (P == Piece::PAWN || P == Piece::BPAWN)
+	{
+		m_pawnHash ^= zobrist::keys.pieces[P][square];
+	}
 }
 
 void State::popPiece(const Piece P, const std::size_t square)
@@ -82,66 +151,254 @@ void State::popPiece(const Piece P, const std::size_t square)
 	m_positions[static_cast<size_t>(P)].reset(square);
 	m_occupancy[static_cast<size_t>(P / 6)].reset(square);
 	m_occupancy[Occupancy::BOTH].reset(square);
+	m_mailbox[square] = Piece::NO_PIECE;
+
+	m_hash ^= zobrist::keys.pieces[P][square];
+
+	if (P == Piece::PAWN || P == Piece::BPAWN)
+	{
+		m_pawnHash ^= zobrist::keys.pieces[P][square];
+	}
+}
+
+void State::putPiece(const Piece P, const std::size_t square)
+{
+	m_positions[P].set(square);
+	m_occupancy[P / 6].set(square);
+	m_occupancy[Occupancy::BOTH].set(square);
+	m_mailbox[square] = P;
 }
 
-void State::popSquare(const std::size_t square)
+void State::removePiece(const Piece P, const std::size_t square)
 {
-	if(m_whiteToMove)
+	m_positions[P].reset(square);
+	m_occupancy[P / 6].reset(square);
+	m_occupancy[Occupancy::BOTH].reset(square);
+	m_mailbox[square] = Piece::NO_PIECE;
+}
+
+void State::shiftPiece(const Piece P, const std::size_t source, const std::size_t target)
+{
+	removePiece(P, source);
+	putPiece(P, target);
+}
+
+Piece State::popSquare(const std::size_t square)
+{
+	const Piece piece{ m_mailbox[square] };
+
+	if (piece != Piece::NO_PIECE)
+	{
+		popPiece(piece, square);
+	}
+
+	return piece;
+}
+
+void State::moveQuiet(const Piece piece, const std::size_t source, const std::size_t target)
+{
+	popPiece(piece, source);
+	setPiece(piece, target);
+}
+
+Piece State::moveCapture(const Piece piece, const std::size_t source, const std::size_t target)
+{
+	const Piece captured{ popSquare(target) };
+	moveQuiet(piece, source, target);
+
+	return captured;
+}
+
+void State::makeMove(const Move move, UndoInfo& undo)
+{
+	undo.hash = m_hash;
+	undo.pawnHash = m_pawnHash;
+	undo.captured = Piece::NO_PIECE;
+	undo.castleRights = m_castleRights;
+	undo.enpassantSquare = static_cast<std::uint8_t>(m_enpassantSquare);
+
+	setEnpassantSquare(no_sqr);
+
+	//unpack
+	const std::size_t source = move.source();
+	const std::size_t target = move.target();
+	const Piece piece = move.piece();
+	const bool promoted = move.promoted();
+	const bool capture = move.capture();
+	const bool double_pawn = move.doublePawnPush();
+	const bool enpassant = move.enpassant();
+	const bool castle = move.castle();
+
+	//if statements in most efficient order for least number of branching
+	if (castle)//TODO: remove moveQuiet and moveCapture they have unnessesary loops and checks. make template function
 	{
-		for (std::size_t piece{ Piece::BPAWN }; piece < PIECE_COUNT; piece++)
+		if (m_whiteToMove)
 		{
-			if (m_positions[piece].test(square))
+			moveQuiet(KING, e1, source);
+
+			if (source == g1)
 			{
-				popPiece(static_cast<Piece>(piece), square);
-				break;
+				moveQuiet(ROOK, h1, f1);
 			}
+			else
+			{
+				moveQuiet(ROOK, a1, d1);
+			}
+
+			//the king moved so both sides lose their rights, not just the rook that moved
+			setCastleRights(e1);
+		}
+		else
+		{
+			moveQuiet(BKING, e8, source);
+
+			if (source == g8)
+			{
+				moveQuiet(BROOK, h8, f8);
+			}
+			else
+			{
+				moveQuiet(BROOK, a8, d8);
+			}
+
+			setCastleRights(e8);
 		}
 	}
 	else
 	{
-		for (std::size_t piece{ Piece::PAWN }; piece < Piece::BPAWN; piece++)
+		setCastleRights(source);
+		setCastleRights(target);
+
+		//captures
+		if (capture)
 		{
-			if (m_positions[piece].test(square))
+			if (promoted)
 			{
-				popPiece(static_cast<Piece>(piece), square);
-				break;
+				undo.captured = m_mailbox[target];
+				popPiece(m_whiteToMove ? Piece::PAWN : Piece::BPAWN, source);
+				popPiece(undo.captured, target);
+				setPiece(piece, target);
+			}
+			else if (enpassant)//TODO: maybe make move enpassant and other compile time known piece movers
+			{
+				if (m_whiteToMove)
+				{
+					popPiece(Piece::PAWN, source);
+					popPiece(Piece::BPAWN, target + 8);
+					setPiece(Piece::PAWN, target);
+				}
+				else
+				{
+					popPiece(Piece::BPAWN, source);
+					popPiece(Piece::PAWN, target - 8);
+					setPiece(Piece::BPAWN, target);
+				}
+			}
+			else
+			{
+				undo.captured = m_mailbox[target];
+				popPiece(undo.captured, target);
+				moveQuiet(piece, source, target);
+			}
+		}
+		//quiets
+		else
+		{
+			if (double_pawn)
+			{//TODO: we know its a pawn we dont have to loop through pieces
+				moveQuiet(m_whiteToMove ? PAWN : BPAWN, source, target);
+				setEnpassantSquare(m_whiteToMove ? source - 8 : source + 8);
+			}
+			else if (promoted)
+			{
+				popPiece(m_whiteToMove ? Piece::PAWN : Piece::BPAWN, source);
+				setPiece(piece, target);
+			}
+			else
+			{
+				moveQuiet(piece, source, target);
 			}
 		}
 	}
 }
 
-void State::moveQuiet(const Piece piece, const std::size_t source, const std::size_t target)
+void State::unmakeMove(const Move move, const UndoInfo& undo)
 {
-	popPiece(piece, source);
-	setPiece(piece, target);
-}
+	const std::size_t source = move.source();
+	const std::size_t target = move.target();
+	const Piece pawn{ m_whiteToMove ? Piece::PAWN : Piece::BPAWN };
 
-void State::moveCapture(const Piece piece, const std::size_t source, const std::size_t target)
-{
-	if (m_whiteToMove)
+	//pieces are put back without touching the keys, they are restored from the undo record below
+	if (move.castle())
 	{
-		for (std::size_t piece{ Piece::BPAWN }; piece < PIECE_COUNT; piece++)
+		if (m_whiteToMove)
 		{
-			if (m_positions[piece].test(target))
+			shiftPiece(KING, source, e1);
+
+			if (source == g1)
 			{
-				popPiece(static_cast<Piece>(piece), target);
-				break;
+				shiftPiece(ROOK, f1, h1);
+			}
+			else
+			{
+				shiftPiece(ROOK, d1, a1);
 			}
 		}
-	}
-	else
-	{
-		for (std::size_t piece{ Piece::PAWN }; piece < Piece::BPAWN; piece++)
+		else
 		{
-			if (m_positions[piece].test(target))
+			shiftPiece(BKING, source, e8);
+
+			if (source == g8)
 			{
-				popPiece(static_cast<Piece>(piece), target);
-				break;
+				shiftPiece(BROOK, f8, h8);
+			}
+			else
+			{
+				shiftPiece(BROOK, d8, a8);
 			}
 		}
 	}
+	else if (move.promoted())
+	{
+		removePiece(move.piece(), target);
+		putPiece(pawn, source);
+	}
+	else if (move.enpassant())
+	{
+		shiftPiece(pawn, target, source);
+		putPiece(m_whiteToMove ? Piece::BPAWN : Piece::PAWN, m_whiteToMove ? target + 8 : target - 8);
+	}
+	else
+	{
+		//double pushes store PAWN for both sides
+		shiftPiece(move.doublePawnPush() ? pawn : move.piece(), target, source);
+	}
 
-	moveQuiet(piece, source, target);
+	if (undo.captured != Piece::NO_PIECE)
+	{
+		putPiece(undo.captured, target);
+	}
+
+	m_castleRights = undo.castleRights;
+	m_enpassantSquare = undo.enpassantSquare;
+	m_hash = undo.hash;
+	m_pawnHash = undo.pawnHash;
+}
+
+void State::makeNullMove(UndoInfo& undo)
+{
+	undo.hash = m_hash;
+	undo.enpassantSquare = static_cast<std::uint8_t>(m_enpassantSquare);
+
+	setEnpassantSquare(no_sqr);
+	flipSide();
+}
+
+void State::unmakeNullMove(const UndoInfo& undo)
+{
+	m_whiteToMove = !m_whiteToMove;
+	m_enpassantSquare = undo.enpassantSquare;
+	m_hash = undo.hash;
 }
 
 void State::printBoard(const bool flipped, const std::size_t source_square) const
@@ -153,15 +410,8 @@ void State::printBoard(const bool flipped, const std::size_t source_square) cons
 			std::cout << (r + 1) << "   ";
 			for (std::size_t f{}; f < FILE_MAX; f++)
 			{
-				char piece_char = '.';
-
-				for (std::size_t i{}; i < PIECE_COUNT; i++)
-				{
-					if (m_positions[i].test_rf(7 - r, 7 - f))
-					{
-						piece_char = piece_to_char[i];
-					}
-				}
+				const Piece piece{ m_mailbox[(7 - r) * RANK_MAX + (7 - f)] };
+				char piece_char = piece == Piece::NO_PIECE ? '.' : piece_to_char[piece];
 
 				const std::size_t square{ r * RANK_MAX + f };
 
@@ -184,16 +434,8 @@ void State::printBoard(const bool flipped, const std::size_t source_square) cons
 			std::cout << (RANK_MAX - r) << "   ";
 			for (std::size_t f{}; f < FILE_MAX; f++)
 			{
-				char piece_char = '.';
-
-				for (std::size_t i{}; i < PIECE_COUNT; i++)
-				{
-
-					if (m_positions[i].test_rf(r, f))
-					{
-						piece_char = piece_to_char[i];
-					}
-				}
+				const Piece piece{ m_mailbox[r * RANK_MAX + f] };
+				char piece_char = piece == Piece::NO_PIECE ? '.' : piece_to_char[piece];
 
 				const std::size_t square{ r * RANK_MAX + f };
 
@@ -215,7 +457,29 @@ State State::parse_fen(const std::string_view fen)
 {
 	State state;
 
-	const std::array<std::string, RANK_MAX> ranks{ split_fen(fen) };
+	//placement, side to move, castle rights and enpassant square, the move counters are not used
+	std::array<std::string_view, 4> fields{};
+	std::size_t field_count{};
+	std::size_t position{};
+
+	while (position < fen.size() && field_count < fields.size())
+	{
+		const std::size_t start{ position };
+
+		while (position < fen.size() && fen[position] != ' ')
+		{
+			position++;
+		}
+
+		if (position > start)
+		{
+			fields[field_count++] = fen.substr(start, position - start);
+		}
+
+		position++;
+	}
+
+	const std::array<std::string, RANK_MAX> ranks{ split_fen(fields[0]) };
 
 	std::size_t index{};
 
@@ -239,6 +503,74 @@ State State::parse_fen(const std::string_view fen)
 		}
 	}
 
+	if (field_count > 1 && fields[1] == "b")
+	{
+		state.m_whiteToMove = false;
+	}
+
+	if (field_count > 2)
+	{
+		state.m_castleRights = 0;
+
+		for (const char c : fields[2])
+		{
+			switch (c)
+			{
+			case 'K':
+				state.m_castleRights |= Castle::WK;
+				break;
+			case 'Q':
+				state.m_castleRights |= Castle::WQ;
+				break;
+			case 'k':
+				state.m_castleRights |= Castle::BK;
+				break;
+			case 'q':
+				state.m_castleRights |= Castle::BQ;
+				break;
+			default:
+				break;
+			}
+		}
+	}
+	else
+	{
+		//board only fen, give every right whose king and rook are still at home so castling can never move a missing piece
+		const std::array<BitBoard, 12>& positions{ state.m_positions };
+		state.m_castleRights = 0;
+
+		if (positions[Piece::KING].test(e1) && positions[Piece::ROOK].test(h1))
+		{
+			state.m_castleRights |= Castle::WK;
+		}
+
+		if (positions[Piece::KING].test(e1) && positions[Piece::ROOK].test(a1))
+		{
+			state.m_castleRights |= Castle::WQ;
+		}
+
+		if (positions[Piece::BKING].test(e8) && positions[Piece::BROOK].test(h8))
+		{
+			state.m_castleRights |= Castle::BK;
+		}
+
+		if (positions[Piece::BKING].test(e8) && positions[Piece::BROOK].test(a8))
+		{
+			state.m_castleRights |= Castle::BQ;
+		}
+	}
+
+	if (field_count > 3 && fields[3].size() == 2)
+	{
+		const std::size_t rank{ static_cast<std::size_t>('8' - fields[3][1]) };
+		const std::size_t file{ static_cast<std::size_t>(fields[3][0] - 'a') };
+
+		state.m_enpassantSquare = rank * RANK_MAX + file;
+	}
+
+	//side, castle and enpassant were set directly so the key is built once at the end
+	state.m_hash = state.generateHash();
+
 	return state;
 }
 
@@ -6,6 +6,17 @@
 #include <string>
 #include <string_view>
 #include "Move.h"
+#include "Zobrist.hpp"
+
+//everything makeMove overwrites that unmakeMove cannot work out from the move itself
+struct UndoInfo
+{
+	std::uint64_t hash;
+	std::uint64_t pawnHash;
+	Piece captured;
+	std::uint8_t castleRights;
+	std::uint8_t enpassantSquare;
+};
 
 struct State
 {
@@ -13,12 +24,19 @@ private:
 	std::array<BitBoard, 12> m_positions;
 	std::array<BitBoard, 3> m_occupancy;
 
+	//piece on every square, kept in step with the bitboards so a square can be looked up without scanning them
+	std::array<Piece, MAX_BOARD_POSITIONS> m_mailbox;
+
 	std::uint8_t m_castleRights;
 
 	std::size_t m_enpassantSquare;
 
 	bool m_whiteToMove;
 
+	//zobrist keys, kept up to date by every function that changes the position
+	std::uint64_t m_hash;
+	std::uint64_t m_pawnHash;
+
 public:
 	State();
 
@@ -44,19 +62,46 @@ public:
 
 	void flipSide();
 
+	std::uint64_t hash() const;
+
+	std::uint64_t pawnHash() const;
+
+	std::uint64_t generateHash() const;
+
+	std::uint64_t generatePawnHash() const;
+
 	void printBoard(const bool flipped, const std::size_t source_square) const;
 
 	void setPiece(const Piece P, const std::size_t square);
 
 	void popPiece(const Piece P, const std::size_t square);
 
-	void popSquare(const std::size_t square);
+	Piece popSquare(const std::size_t square);
 
 	void moveQuiet(const Piece P, const std::size_t source, const std::size_t target);
 
-	void moveCapture(const Piece P, const std::size_t source, const std::size_t target);
+	Piece moveCapture(const Piece P, const std::size_t source, const std::size_t target);
+
+	//plays a move in place without checking legality, the side to move is not flipped
+	void makeMove(const Move move, UndoInfo& undo);
+
+	//takes back the last makeMove, the side to move has to be the side that played it
+	void unmakeMove(const Move move, const UndoInfo& undo);
+
+	//passes the turn, the en passant square goes away just like after a real move
+	void makeNullMove(UndoInfo& undo);
+
+	void unmakeNullMove(const UndoInfo& undo);
 
 	static State parse_fen(const std::string_view fen);
 
 	static std::array<std::string, RANK_MAX> split_fen(std::string_view fen);
+
+private:
+	//same as setPiece, popPiece and moveQuiet but the keys are left alone, only used by unmakeMove
+	void putPiece(const Piece P, const std::size_t square);
+
+	void removePiece(const Piece P, const std::size_t square);
+
+	void shiftPiece(const Piece P, const std::size_t source, const std::size_t target);
 };
\ No newline at end of file
@@ -0,0 +1,15 @@
+#include "TableSize.h"
+#include <algorithm>
+
+std::size_t table_bucket_count(const std::size_t megabytes, const std::size_t bucket_size)
+{
+	const std::size_t max_buckets{ (std::max<std::size_t>(megabytes, 1) * 1024 * 1024) / bucket_size };
+
+	std::size_t bucket_count{ 1 };
+	while (bucket_count * 2 <= max_buckets)
+	{
+		bucket_count *= 2;
+	}
+
+	return bucket_count;
+}
\ No newline at end of file
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <cstddef>
+
+//the most buckets of the given size that fit in the budget, rounded down to a power of two so the index is a mask instead of a modulo
+//shared by the transposition table and the perft table, at least one bucket even when the budget is 0
+std::size_t table_bucket_count(const std::size_t megabytes, const std::size_t bucket_size);
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "TranspositionTable.h"
+#include "TableSize.h"
+
+TranspositionTable::TranspositionTable(const std::size_t megabytes)
+	: m_buckets(), m_bucketMask(), m_age()
+{
+	resize(megabytes);
+}
+
+void TranspositionTable::resize(const std::size_t megabytes)
+{
+	const std::size_t bucket_count{ table_bucket_count(megabytes, sizeof(Bucket)) };
+
+	m_buckets = std::vector<Bucket>(bucket_count);
+	m_bucketMask = bucket_count - 1;
+	m_age = 0;
+}
+
+void TranspositionTable::clear()
+{
+	for (Bucket& bucket : m_buckets)
+	{
+		for (Slot& slot : bucket.m_slots)
+		{
+			slot.m_key.store(0, std::memory_order_relaxed);
+			slot.m_data.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	m_age = 0;
+}
+
+void TranspositionTable::incrementAge()
+{
+	m_age = (m_age + 1) % tt_age_cycle;
+}
+
+bool TranspositionTable::probe(const std::uint64_t key, TTEntry& entry_out) const
+{
+	const Bucket& bucket{ m_buckets[key & m_bucketMask] };
+
+	for (const Slot& slot : bucket.m_slots)
+	{
+		const std::uint64_t data{ slot.m_data.load(std::memory_order_relaxed) };
+		const std::uint64_t slot_key{ slot.m_key.load(std::memory_order_relaxed) ^ data };
+
+		if (slot_key == key && data)
+		{
+			entry_out.move = Move::fromData(static_cast<std::uint32_t>(data & tt_move_mask));
+			entry_out.score = static_cast<std::int16_t>((data & tt_score_mask) >> tt_score_shift);
+			entry_out.depth = slotDepth(data);
+			entry_out.bound = static_cast<Bound>((data & tt_bound_mask) >> tt_bound_shift);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void TranspositionTable::store(const std::uint64_t key, const std::uint32_t depth, const Bound bound, const int score, const Move move)
+{
+	Bucket& bucket{ m_buckets[key & m_bucketMask] };
+	Slot* replace{ &bucket.m_slots[0] };
+	std::uint64_t replace_data{ replace->m_data.load(std::memory_order_relaxed) };
+	bool same_position{ false };
+	int replace_worth{ INT_MAX };
+
+	//no locks, another thread may change a slot while we look at it which only costs a worse replacement choice
+	for (Slot& slot : bucket.m_slots)
+	{
+		const std::uint64_t data{ slot.m_data.load(std::memory_order_relaxed) };
+		const std::uint64_t slot_key{ slot.m_key.load(std::memory_order_relaxed) ^ data };
+
+		//same position, overwrite unless we would throw away a deeper exact result from this search
+		if (slot_key == key)
+		{
+			if (bound != Bound::EXACT && slotAge(data) == m_age && slotDepth(data) > depth + 2)
+			{
+				return;
+			}
+
+			replace = &slot;
+			replace_data = data;
+			same_position = true;
+			break;
+		}
+
+		//otherwise evict the shallowest slot, entries from older searches count as shallower
+		const std::uint8_t age_difference{ static_cast<std::uint8_t>((tt_age_cycle + m_age - slotAge(data)) % tt_age_cycle) };
+		const int worth{ static_cast<int>(slotDepth(data)) - 8 * age_difference };
+
+		if (worth < replace_worth)
+		{
+			replace_worth = worth;
+			replace = &slot;
+			replace_data = data;
+		}
+	}
+
+	//keep the old best move if this search did not find one
+	const Move best_move{ (move.data() || !same_position) ? move : Move::fromData(static_cast<std::uint32_t>(replace_data & tt_move_mask)) };
+	const std::uint64_t data{ pack(best_move, score, depth, bound, m_age) };
+
+	replace->m_data.store(data, std::memory_order_relaxed);
+	replace->m_key.store(key ^ data, std::memory_order_relaxed);
+}
+
+std::size_t TranspositionTable::sizeMB() const
+{
+	return (m_buckets.size() * sizeof(Bucket)) / (1024 * 1024);
+}
+
+int TranspositionTable::scoreToTT(const int score, const std::uint32_t ply)
+{
+	if (score > CHECKMATE_THRESHOLD)
+	{
+		return score + static_cast<int>(ply);
+	}
+	else if (score < -CHECKMATE_THRESHOLD)
+	{
+		return score - static_cast<int>(ply);
+	}
+	else
+	{
+		return score;
+	}
+}
+
+int TranspositionTable::scoreFromTT(const int score, const std::uint32_t ply)
+{
+	if (score > CHECKMATE_THRESHOLD)
+	{
+		return score - static_cast<int>(ply);
+	}
+	else if (score < -CHECKMATE_THRESHOLD)
+	{
+		return score + static_cast<int>(ply);
+	}
+	else
+	{
+		return score;
+	}
+}
+
+std::uint64_t TranspositionTable::pack(const Move move, const int score, const std::uint32_t depth, const Bound bound, const std::uint8_t age)
+{
+	return static_cast<std::uint64_t>(move.data())
+		| (static_cast<std::uint64_t>(static_cast<std::uint16_t>(score)) << tt_score_shift)
+		| (static_cast<std::uint64_t>(std::min<std::uint32_t>(depth, UINT8_MAX)) << tt_depth_shift)
+		| (static_cast<std::uint64_t>(bound) << tt_bound_shift)
+		| (static_cast<std::uint64_t>(age) << tt_age_shift);
+}
+
+std::uint8_t TranspositionTable::slotAge(const std::uint64_t data)
+{
+	return static_cast<std::uint8_t>((data & tt_age_mask) >> tt_age_shift);
+}
+
+std::uint32_t TranspositionTable::slotDepth(const std::uint64_t data)
+{
+	return static_cast<std::uint32_t>((data & tt_depth_mask) >> tt_depth_shift);
+}
\ No newline at end of file
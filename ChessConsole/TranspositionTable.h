@@ -0,0 +1,88 @@
+#pragma once
+
+#include "ChessConstants.hpp"
+#include "Move.h"
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <atomic>
+
+constexpr std::size_t tt_score_shift{ 32 };
+constexpr std::size_t tt_depth_shift{ 48 };
+constexpr std::size_t tt_bound_shift{ 56 };
+constexpr std::size_t tt_age_shift{ 58 };
+
+constexpr std::uint64_t tt_move_mask         { 0x00000000FFFFFFFF };
+constexpr std::uint64_t tt_score_mask        { 0x0000FFFF00000000 };
+constexpr std::uint64_t tt_depth_mask        { 0x00FF000000000000 };
+constexpr std::uint64_t tt_bound_mask        { 0x0300000000000000 };
+constexpr std::uint64_t tt_age_mask          { 0xFC00000000000000 };
+
+constexpr std::uint8_t  tt_age_cycle{ 64 };
+
+enum Bound {
+	NO_BOUND = 0,
+	EXACT = 1,
+	LOWER = 2, //fail high, score is at least this
+	UPPER = 3  //fail low, score is at most this
+};
+
+struct TTEntry
+{
+	Move move;
+	int score;
+	std::uint32_t depth;
+	Bound bound;
+};
+
+class TranspositionTable
+{
+private:
+	//one 16 byte slot, the move, score, depth, bound and age are packed into m_data.
+	//m_key holds key ^ data so a slot torn by two threads writing at once fails the key check
+	struct Slot
+	{
+		std::atomic<std::uint64_t> m_key;
+		std::atomic<std::uint64_t> m_data;
+	};
+
+	//a bucket fills exactly one cache line so a probe touches memory once
+	struct alignas(64) Bucket
+	{
+		std::array<Slot, TRANSPOSITION_BUCKET_SIZE> m_slots;
+	};
+
+	std::vector<Bucket> m_buckets;
+	std::size_t m_bucketMask;
+	std::uint8_t m_age;
+
+public:
+	TranspositionTable(const std::size_t megabytes);
+
+	void resize(const std::size_t megabytes);
+
+	void clear();
+
+	void incrementAge();
+
+	bool probe(const std::uint64_t key, TTEntry& entry_out) const;
+
+	void store(const std::uint64_t key, const std::uint32_t depth, const Bound bound, const int score, const Move move);
+
+	std::size_t sizeMB() const;
+
+	//mate scores are stored as distance from the node instead of from the root
+	static int scoreToTT(const int score, const std::uint32_t ply);
+
+	static int scoreFromTT(const int score, const std::uint32_t ply);
+
+private:
+	static std::uint64_t pack(const Move move, const int score, const std::uint32_t depth, const Bound bound, const std::uint8_t age);
+
+	static std::uint8_t slotAge(const std::uint64_t data);
+
+	static std::uint32_t slotDepth(const std::uint64_t data);
+};
\ No newline at end of file
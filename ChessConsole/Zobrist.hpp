@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <array>
+#include <cstddef>
+#include "ChessConstants.hpp"
+
+namespace zobrist
+{
+	constexpr std::uint64_t seed = 0x9E3779B97F4A7C15;
+
+	//splitmix64, small enough to run inside the compiler
+	constexpr std::uint64_t next_key(std::uint64_t& state)
+	{
+		state += 0x9E3779B97F4A7C15;
+
+		std::uint64_t key{ state };
+		key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9;
+		key = (key ^ (key >> 27)) * 0x94D049BB133111EB;
+
+		return key ^ (key >> 31);
+	}
+
+	struct Keys
+	{
+		std::array<std::array<std::uint64_t, MAX_BOARD_POSITIONS>, PIECE_COUNT> pieces;
+		std::array<std::uint64_t, 16> castle;
+		std::array<std::uint64_t, MAX_BOARD_POSITIONS + 1> enpassant; //last entry is no_sqr and stays 0
+		std::uint64_t side;
+	};
+
+	constexpr Keys create_keys()
+	{
+		Keys keys{};
+		std::uint64_t state{ seed };
+
+		for (auto& piece : keys.pieces)
+		{
+			for (auto& square : piece)
+			{
+				square = next_key(state);
+			}
+		}
+
+		for (auto& castle : keys.castle)
+		{
+			castle = next_key(state);
+		}
+
+		for (std::size_t square{}; square < MAX_BOARD_POSITIONS; square++)
+		{
+			keys.enpassant[square] = next_key(state);
+		}
+
+		keys.side = next_key(state);
+
+		return keys;
+	}
+
+	constexpr Keys keys = create_keys();
+}
\ No newline at end of file